@@ -6,33 +6,263 @@
 #include "ADS7828.h"
 #include "_24XX1026.h"
 #include "protocol.h"
+#include "breath.h"
+#include "goertzel.h"
+#include "epoch.h"
+#include "pressure.h"
+#include "calibration.h"
+#include "config.h"
+#include "clock.h"
+#include "probe.h"
+#include "xbee.h"
+#include "transmit.h"
+#include "scheduler.h"
+#include "bus.h"
+#include "adaptive.h"
+#include "battery.h"
+#include "health.h"
 
 #define BUFFER_SIZE 128
+/* Serial link's rates in bps, the radio's BD register must match. */
+#define SERIAL_RATE_DEFAULT 9600
+#define SERIAL_RATE_MAX 115200
+#define BAUD_TIMEOUT 1000
+/* Pin driving the radio's SLEEP_RQ (pin hibernate, ATSM1), and its wake up time in ms. */
+#define RADIO_SLEEP_PIN 7
+#define RADIO_WAKE_DELAY 15
+/* Size of the ring of the platform's frames waiting to be handled, whole frames only. */
+#define RX_RING_SIZE 64
+/* Longest wait of the platform's commands while sleeping between two samples in ms. */
+#define COMMAND_POLL_PERIOD 20
+/* Period of the STA telemetry frames in ms. */
+#define TELEMETRY_PERIOD 600000
+/* Time a step of a burst holds the bus at most in us, moving a packet through the spool : read back with its header
+   and the next one, three reads each polled and addressed, or written on two pages. */
+#define SPOOL_READ_TIME bus_getTime(1 + TRANSMIT_PACKET_SIZE + 2 * (1 + PROTOCOL_SEQ_SIZE) + 3 * 2, 3 * 3, 0)
+#define SPOOL_WRITE_TIME bus_getTime(1 + TRANSMIT_PACKET_SIZE + 2 * 2, 2, 2)
+#define SPOOL_STEP_TIME ((SPOOL_READ_TIME > SPOOL_WRITE_TIME) ? SPOOL_READ_TIME : SPOOL_WRITE_TIME)
+/* Air time of a packet and its acknowledgment at 250 kbps in ms. */
+#define RADIO_TX_TIME 5
 
 uint32_t id1;
 uint32_t id2;
 
+/* Raw DR1/DCN streaming requested by the platform, breathing summaries otherwise. */
+bool bRawStream = false;
+/* Raw monitoring in DAN frames, FSR and FSC sampled on the same tick. */
+bool bSyncStream = false;
+/* Raw monitoring whose periods follow the activity. */
+bool bAdaptive = false;
+struct sAdaptive adaptive;
+/* Raw monitoring whose FSC's waves are taken at a high rate, by windows of a DCH frame. */
+bool bHighRate = false;
+/* Period of the windows in ms : their waves, then the draining of their frame. */
+uint32_t hfcWindow;
+/* Rate of the serial link with the radio in bps. */
+uint32_t serialRate = SERIAL_RATE_DEFAULT;
+/* Monitoring run with the low power profile of a low battery. */
+bool bLowProfile = false;
+/* Period of the FSR's sweeps of the current watch in ms. */
+uint32_t watchPeriod;
+struct sBattery battery;
+struct sHealthTracker health;
+/* Someone lies on the bed and acquisitionMode() monitors breathing. */
+bool bMonitoring = false;
+struct sBreathEstimator breathEstimator;
+struct sGoertzelBank goertzelBank;
+struct sEpochAggregator epochAggregator;
+struct sPressureDetector bedDetector;
+struct sCalibrationTable calibration;
+struct sConfig config;
+struct sClock clockSync;
+_24XX1026Manager eeprom(0);
+
 bool mysleep(uint32_t delay, uint32_t timeout);
-bool acquisitionMode(const uint32_t timeMax, const uint32_t fsrDelay, const uint32_t fscDelay, uint8_t buffer[BUFFER_SIZE], uint16_t* bufferPos);
-uint8_t sleepMode(const uint32_t timeMax, const uint32_t delay, const uint16_t delta, uint8_t buffer[BUFFER_SIZE], uint16_t* bufferPos);
+bool acquisitionMode(const uint32_t timeMax, uint8_t buffer[BUFFER_SIZE], uint16_t* bufferPos);
+uint8_t sleepMode(const uint32_t timeMax, const uint16_t delta, uint8_t buffer[BUFFER_SIZE], uint16_t* bufferPos);
 void manager(void);
 
 bool sendData(uint8_t* buffer, uint16_t size)
 {
-	Serial.write(buffer, size);
+	bool bDelivered = true;
+	uint8_t chunk;
+	uint32_t start;
+
+	while (size > 0)
+	{
+		chunk = (size > XBEE_PAYLOAD_MAX) ? XBEE_PAYLOAD_MAX : size;
+		start = probe_now();
+		bDelivered = (xbee_sendAndWait(buffer, chunk, XBEE_TX_TIMEOUT) == cXbeeStatusSuccess) && bDelivered;
+		probe_record(cProbeSend, start);
+		buffer += chunk;
+		size -= chunk;
+	}
+
+	return bDelivered;
+}
+
+int xbeeRead(void)
+{
+	return Serial.read();
+}
+
+void xbeeWrite(const uint8_t c)
+{
+	Serial.write(c);
+}
+
+uint32_t xbeeMillis(void)
+{
+	return millis();
+}
+
+int (*xbee_readChar)(void) = &xbeeRead;
+void (*xbee_writeChar)(const uint8_t c) = &xbeeWrite;
+uint32_t (*xbee_millis)(void) = &xbeeMillis;
+void xbeeReceive(uint8_t const* data, const uint8_t size);
+void (*xbee_onReceive)(uint8_t const* data, const uint8_t size) = &xbeeReceive;
+
+/* Frame identifier of the last packet handed to the radio by the transmit scheduler. */
+uint8_t radioFrameId;
+/* A SYN request is queued : the first packet handed to the radio carries it, the copy of the event frames. */
+bool bSynQueued = false;
+
+bool radioSend(uint8_t const* data, const uint8_t size)
+{
+	uint32_t start = probe_now();
+
+	if (bSynQueued)
+		clock_stamp(&clockSync, millis());
+	/* The burst waits for the status between two steps. */
+	radioFrameId = xbee_send(data, size);
+	probe_record(cProbeSend, start);
 	return true;
 }
 
+eXbeeStatus radioStatus(void)
+{
+	eXbeeStatus status = xbee_getStatus(radioFrameId);
+
+	/* Stamped again when sent again. */
+	if (status == cXbeeStatusSuccess)
+		bSynQueued = false;
+	return status;
+}
+
+void radioPower(const bool bOn)
+{
+	digitalWrite(RADIO_SLEEP_PIN, bOn ? LOW : HIGH);
+	if (bOn)
+		delay(RADIO_WAKE_DELAY);
+}
+
+void radioReceive(void)
+{
+	/* ACK and NAK frames are handled by xbeeReceive(). */
+	xbee_poll();
+}
+
+bool spoolWrite(const uint32_t addr, uint8_t const* data, const uint16_t size)
+{
+	uint32_t start = probe_now();
+	bool bOk;
+
+	bOk = eeprom.setCursor(addr) && (eeprom.write((uint8_t*)data, size) == size);
+	bus_end(millis());
+	probe_record(cProbeSpool, start);
+	return bOk;
+}
+
+bool spoolRead(const uint32_t addr, uint8_t* data, const uint16_t size)
+{
+	uint32_t start = probe_now();
+	bool bOk;
+
+	bOk = eeprom.setCursor(addr) && (eeprom.read(data, size) == size);
+	bus_end(millis());
+	probe_record(cProbeSpool, start);
+	return bOk;
+}
+
+uint32_t transmitMillis(void)
+{
+	return millis();
+}
+
+bool (*transmit_radioSend)(uint8_t const* data, const uint8_t size) = &radioSend;
+eXbeeStatus (*transmit_radioStatus)(void) = &radioStatus;
+void (*transmit_radioPower)(const bool bOn) = &radioPower;
+void (*transmit_radioReceive)(void) = &radioReceive;
+bool (*transmit_spoolWrite)(const uint32_t addr, uint8_t const* data, const uint16_t size) = &spoolWrite;
+bool (*transmit_spoolRead)(const uint32_t addr, uint8_t* data, const uint16_t size) = &spoolRead;
+uint32_t (*transmit_millis)(void) = &transmitMillis;
+
+uint32_t schedulerMillis(void)
+{
+	return millis();
+}
+
+bool (*scheduler_sleep)(const uint32_t delay, const uint32_t end) = &mysleep;
+uint32_t (*scheduler_millis)(void) = &schedulerMillis;
+
+void queueData(uint8_t const* buffer, const uint16_t size, const eTransmitClass frameClass)
+{
+	/* Sent by pollTransmit(), away from the sampling. */
+	transmit_push(buffer, size, frameClass);
+}
+
+/* Runs a step of the transmit scheduler if it ends before the reserved sweep : a packet through the spool,
+   then on the serial link at 10 bits a byte, the serial buffer holding far less than a packet. */
+void pollTransmit(void)
+{
+	const uint32_t serial = (((uint32_t)(TRANSMIT_PACKET_SIZE + XBEE_TX_OVERHEAD) * 10 * 1000 + serialRate - 1) / serialRate) * 1000;
+
+	if (bus_mayTransfer(SPOOL_STEP_TIME + serial, millis()))
+		transmit_poll();
+}
+
 bool getFSRSensor(uint16_t* values)
 {
 	uint8_t i;
-	ADS7828_getAllValues(0b00, ADS7828_AD_CONVERTER_ON | ADS7828_INTERNAL_REF_ON | ADS7828_SINGLE_ENDED_I, false, values);
+	uint8_t ret;
+	uint16_t faulty;
+	uint32_t start = probe_now();
+
+	ret = ADS7828_getAllValues(0b00, ADS7828_AD_CONVERTER_ON | ADS7828_INTERNAL_REF_ON | ADS7828_SINGLE_ENDED_I, false, values);
+	if (ret != TWI_SUCCESS)
+		probe_count(cProbeCounterI2c);
+	faulty = (ret == TWI_SUCCESS) ? health_update(&health, values, config.fsrMask) : health.faulty;
 	for (i = 0 ; i < PROTOCOL_FSR_NUMBER ; i++)
 	{
-		values[i] /= 2;
+		/* Channels out of use or unhealthy read as unloaded. */
+		values[i] = ((config.fsrMask & ~faulty) & (1 << i)) ? calibration_apply(&calibration, i, values[i]) / 2 : 0;
 	}
+	probe_record(cProbeSweep, start);
 
-	return true;
+	return (ret == TWI_SUCCESS);
+}
+
+eProtocolEvent bedEvent(uint16_t const* fsrValues, const uint32_t time)
+{
+	struct sPressure sPress;
+	struct sProtocolEVT sEvt;
+	tProtocol_bufferEVT evtBuf;
+	eProtocolEvent event;
+
+	pressure_compute(fsrValues, &sPress);
+	event = pressure_detect(&bedDetector, &sPress);
+	if (event != cProtocolEventUnknow)
+	{
+		sEvt.time  = time;
+		sEvt.event = event;
+		sEvt.copX  = sPress.x;
+		sEvt.copY  = sPress.y;
+		sEvt.load  = sPress.load;
+		/* Urgent : its class wakes up the radio at once. */
+		queueData(evtBuf, protocol_createEVT(&sEvt, evtBuf), cTransmitClassEvent);
+	}
+
+	return event;
 }
 
 bool getFSCSensor(uint16_t* values)
@@ -40,304 +270,816 @@ bool getFSCSensor(uint16_t* values)
 	uint16_t i;
 	for (i = 0 ; i < PROTOCOL_FSC_NUMBER ; i++)
 		values[i] = random() / RAND_MAX * 2048;
+	calibration_applyFSC(&calibration, values);
+	for (i = 0 ; i < PROTOCOL_FSC_NUMBER ; i++)
+		if (!(config.fscMask & (1 << i)))
+			values[i] = 0;
 
 	return true;
 }
 
-char monRead(void){
-	char rep;
-	scanf("%c%*c", &rep);
-	return rep;
+void loadCalibration(void)
+{
+	eeprom.setCursor(CALIBRATION_EEPROM_ADDR);
+	if (eeprom.read((uint8_t*)&calibration, sizeof(calibration)) != sizeof(calibration) || !calibration_isValid(&calibration))
+		calibration_setIdentity(&calibration);
+}
+
+bool setCalibration(struct sProtocolCAL const* sCal)
+{
+	calibration_set(&calibration, sCal);
+	eeprom.setCursor(CALIBRATION_EEPROM_ADDR);
+	return (eeprom.write((uint8_t*)&calibration, sizeof(calibration)) == sizeof(calibration));
+}
+
+void loadConfig(void)
+{
+	/* A single read at a fixed address, whatever was stored before. */
+	eeprom.setCursor(CONFIG_EEPROM_ADDR);
+	if (eeprom.read((uint8_t*)&config, sizeof(config)) != sizeof(config) || !config_isValid(&config))
+		config_setDefaults(&config);
+}
+
+bool saveConfig(void)
+{
+	eeprom.setCursor(CONFIG_EEPROM_ADDR);
+	return (eeprom.write((uint8_t*)&config, sizeof(config)) == sizeof(config));
+}
+
+/* Frames of the platform waiting for pollCommands(). */
+uint8_t rxRing[RX_RING_SIZE];
+uint8_t rxTail = 0;
+uint8_t rxCount = 0;
+/* Packet being received, read before the ring for the acknowledgments. */
+uint8_t const* rxPacket = NULL;
+uint8_t rxPacketSize = 0;
+uint8_t rxPacketPos = 0;
+
+/* Mode ordered by the platform, cProtocolModeUnknow once applied. */
+eProtocolMode modeRequest = cProtocolModeUnknow;
+
+char rxRead(void)
+{
+	char c;
+
+	/* An exhausted source reads as end of frames so parsers never block. */
+	if (rxPacket != NULL)
+		return (rxPacketPos < rxPacketSize) ? rxPacket[rxPacketPos++] : PROTOCOL_FRAME_END;
+	if (rxCount == 0)
+		return PROTOCOL_FRAME_END;
+	c = rxRing[rxTail];
+	rxTail = (rxTail + 1) % RX_RING_SIZE;
+	rxCount--;
+
+	return c;
 }
 
-char (*protocol_readChar)(void) = &monRead;
+char (*protocol_readChar)(void) = &rxRead;
+
+eProtocolFrame readFrameId(void)
+{
+	char frameId[PROTOCOL_FRAME_TYPE_SIZE];
+	uint8_t i;
 
+	if (!protocol_isStartOfFrame())
+		return cProtocolFrameUnknow;
+	for (i = 0 ; i < PROTOCOL_FRAME_TYPE_SIZE ; i++)
+		frameId[i] = protocol_readChar();
+
+	return protocol_isSeparator() ? protocol_frameIdentification(frameId) : cProtocolFrameUnknow;
+}
+
+/* Current time on the platform's clock, for timestamps only. */
+uint32_t platformTime(void)
+{
+	return clock_toPlatform(&clockSync, millis());
+}
+
+/* Hands the acknowledgments to the transmit scheduler and the clock's answers to the synchronization, true if the frame is one. */
+bool linkFrame(void)
+{
+	uint16_t seq;
+	uint16_t arg;
+	uint32_t time;
+
+	switch (readFrameId())
+	{
+		case cProtocolFrameACK :
+			if (protocol_parseACK(&seq, &arg))
+				transmit_acknowledge(seq, arg);
+			return true;
+		case cProtocolFrameNAK :
+			if (protocol_parseNAK(&seq, &arg))
+				transmit_resend(seq, arg);
+			return true;
+		case cProtocolFrameSYN :
+			/* Stamped on reception, the round trip must not include the wait for the next sample. */
+			if (protocol_parseSYN(&time))
+				clock_receive(&clockSync, time, millis());
+			return true;
+		default :
+			return false;
+	}
+}
+
+void xbeeReceive(uint8_t const* data, const uint8_t size)
+{
+	uint8_t i;
+	uint8_t pos;
+	uint16_t frameSize;
+
+	/* Acknowledgments come at any time, even in the middle of a burst, the platform's SYN along with them, anywhere in the packet. */
+	rxPacket = data;
+	rxPacketSize = size;
+	for (pos = 0 ; pos < size ; pos += frameSize)
+	{
+		rxPacketPos = pos;
+		if (linkFrame())
+		{
+			frameSize = rxPacketPos - pos;
+			continue;
+		}
+		frameSize = protocol_getFrameSize(data + pos, size - pos);
+		if (frameSize == 0)
+		{
+			/* Unknown or broken : skipped up to the next start of frame. */
+			for (frameSize = 1 ; pos + frameSize < size && data[pos + frameSize] != PROTOCOL_FRAME_START ; frameSize++)
+				;
+		}
+		/* Commands wait for the next sample, a frame which doesn't fit is lost. */
+		else if (frameSize <= RX_RING_SIZE - rxCount)
+			for (i = 0 ; i < frameSize ; i++)
+				rxRing[(rxTail + rxCount++) % RX_RING_SIZE] = data[pos + i];
+	}
+	rxPacket = NULL;
+}
+
+/* Applies the encoding options of the configuration. */
+void applyOptions(void)
+{
+	bool bRaw = ((config.options & CONFIG_OPTION_RAW) != 0);
+
+	/* A monitoring changes its encoding through a restart. */
+	if (!bMonitoring)
+		bRawStream = bRaw;
+	else if (bRaw != bRawStream)
+		modeRequest = bRaw ? cProtocolModeAccurate : cProtocolModeNormal;
+}
+
+/* Handles the platform's commands, between two samples : a few bytes, never a wait. */
+void pollCommands(void)
+{
+	struct sProtocolCAL sCal;
+	tProtocol_bufferSYN synBuf;
+	tProtocol_bufferCFG cfgBuf;
+	uint32_t value;
+	eProtocolMode mode;
+	eProtocolConfig key;
+
+	/* The serial interrupt buffers the radio, its frames are decoded here. */
+	xbee_poll();
+	while (rxCount > 0)
+	{
+		switch (readFrameId())
+		{
+			case cProtocolFrameMOD :
+				if (protocol_parseMOD(&mode))
+					modeRequest = mode;
+				break;
+			case cProtocolFrameCAL :
+				if (protocol_parseCAL(&sCal))
+					setCalibration(&sCal);
+				break;
+			case cProtocolFrameCFG :
+				if (protocol_parseCFG(&key, &value))
+				{
+					if (config_set(&config, key, value))
+					{
+						saveConfig();
+						applyOptions();
+					}
+					/* Answered with the value in use, so a rejected one is noticed. */
+					transmit_push(cfgBuf, protocol_createCFG(key, config_get(&config, key), cfgBuf), cTransmitClassEvent);
+				}
+				break;
+			default :
+				/* Unknown or broken : skipped up to the next start of frame. */
+				break;
+		}
+	}
+	/* Alone in its burst, and stamped by radioSend() when it leaves. */
+	if (transmit_isEmpty() && clock_isDue(&clockSync, millis()))
+		bSynQueued = transmit_push(synBuf, clock_request(&clockSync, millis(), synBuf), cTransmitClassEvent);
+}
+
+/* Applies the mode ordered by the platform, true if the current monitoring must end. */
+bool endMonitoring(void)
+{
+	bool bEnd = false;
+
+	switch (modeRequest)
+	{
+		case cProtocolModeSleep :
+			bEnd = true;
+			modeRequest = cProtocolModeUnknow;
+			break;
+		case cProtocolModeNormal :
+		case cProtocolModeAccurate :
+			/* Another resolution needs a new monitoring, started by sleepMode() at once. */
+			bEnd = ((modeRequest == cProtocolModeAccurate) != bRawStream);
+			if (!bEnd)
+				modeRequest = cProtocolModeUnknow;
+			break;
+		default :
+			break;
+	}
+
+	return bEnd;
+}
+
+bool waitFrame(const eProtocolFrame type, const uint32_t timeout)
+{
+	uint32_t start;
+
+	start = millis();
+	do
+	{
+		xbee_poll();
+		/* Other frames are dropped. */
+		while (rxCount > 0)
+			if (readFrameId() == type)
+				return true;
+	} while (millis() - start < timeout);
+
+	return false;
+}
+
+bool setBaudRate(const uint32_t rate)
+{
+	uint8_t code = xbee_baudCode(rate);
+
+	if (code == XBEE_BAUD_UNKNOWN)
+		return false;
+	/* The radio answers AC at the old rate, then switches. */
+	if (!xbee_setAT(PSTR("BD"), code, 1, XBEE_AT_TIMEOUT) || !xbee_setAT(PSTR("AC"), 0, 0, XBEE_AT_TIMEOUT))
+		return false;
+	Serial.flush();
+	Serial.end();
+	Serial.begin(rate);
+
+	return true;
+}
+
+void fallbackBaudRate(const uint32_t rate)
+{
+	/* The radio could have switched without us knowing it : try both rates. */
+	if (!setBaudRate(SERIAL_RATE_DEFAULT))
+	{
+		Serial.end();
+		Serial.begin(rate);
+		if (!setBaudRate(SERIAL_RATE_DEFAULT))
+		{
+			Serial.end();
+			Serial.begin(SERIAL_RATE_DEFAULT);
+		}
+	}
+}
+
+uint32_t negotiateBaudRate(void)
+{
+	tProtocol_bufferBDR bdrBuf;
+	uint32_t rate;
+	uint32_t code;
+
+	/* Offer our highest rate, the platform answers with the one it accepts. */
+	if (!sendData(bdrBuf, protocol_createBDR(SERIAL_RATE_MAX, bdrBuf)) || !waitFrame(cProtocolFrameBDR, BAUD_TIMEOUT) || !protocol_parseBDR(&rate))
+		return SERIAL_RATE_DEFAULT;
+	if (rate == SERIAL_RATE_DEFAULT || rate > SERIAL_RATE_MAX)
+		rate = SERIAL_RATE_DEFAULT;
+	else
+	{
+		/* Loopback self-test : the radio reads back BD and the platform receives our confirmation, both at the new rate. */
+		if (setBaudRate(rate) && xbee_getAT(PSTR("BD"), &code, XBEE_AT_TIMEOUT) && code == xbee_baudCode(rate) && sendData(bdrBuf, protocol_createBDR(rate, bdrBuf)))
+			return rate;
+		fallbackBaudRate(rate);
+		rate = SERIAL_RATE_DEFAULT;
+	}
+	sendData(bdrBuf, protocol_createBDR(rate, bdrBuf));
+
+	return rate;
+}
+
+
+/* Supply voltage in mV : the internal 1.1 V bandgap converted against AVcc, the battery's with a cell feeding Vcc directly. */
+uint16_t readVcc(void)
+{
+	uint16_t value;
+
+	ADMUX = _BV(REFS0) | _BV(MUX3) | _BV(MUX2) | _BV(MUX1);
+	/* The bandgap settles after its selection. */
+	delay(2);
+	ADCSRA |= _BV(ADSC);
+	while (bit_is_set(ADCSRA, ADSC))
+		;
+	value = ADC;
+
+	return (value == 0) ? 0 : (uint16_t)(1125300UL / value);
+}
+
+/* Measures the battery, reported on change and on schedule. */
+void checkBattery(void)
+{
+	struct sProtocolBAT sBat;
+	tProtocol_bufferBAT batBuf;
+
+	if (battery_update(&battery, readVcc(), millis()))
+	{
+		battery_getReport(&battery, &sBat, millis());
+		sBat.time = platformTime();
+		transmit_push(batBuf, protocol_createBAT(&sBat, batBuf), battery_isLow(&battery) ? cTransmitClassEvent : cTransmitClassSummary);
+	}
+}
+
+/* Sends the telemetry of the last period with the summaries. */
+void sendTelemetry(void)
+{
+	static uint16_t dropped = 0;
+	struct sProtocolSTA sSta;
+	struct sTransmitStats sStats;
+	tProtocol_bufferSTA staBuf;
+	struct sProtocolCHS sChs;
+	tProtocol_bufferCHS chsBuf;
+
+	probe_getSummary(&sSta);
+	/* Counted by the transmit scheduler itself. */
+	transmit_getStats(&sStats);
+	sSta.counters[cProbeCounterDropped] = sStats.nbDropped - dropped;
+	dropped = sStats.nbDropped;
+	sSta.busDelay = bus_getWorstDelay();
+	sSta.time = platformTime();
+	transmit_push(staBuf, protocol_createSTA(&sSta, staBuf), cTransmitClassSummary);
+	health_getReport(&health, &sChs);
+	sChs.time = sSta.time;
+	transmit_push(chsBuf, protocol_createCHS(&sChs, chsBuf), cTransmitClassSummary);
+}
 
 uint8_t buffer[BUFFER_SIZE];
-uint8_t ackBuf[PROTOCOL_ACK_SIZE];
 uint16_t bufferPos = 0;
 uint16_t old;
+uint32_t telemetryTime;
+uint32_t batteryTime;
 
 void setup()
 {
 	id1 = 0;
 	id2 = 0;
-	Serial.begin(9600);
+	probe_init();
+	Serial.begin(SERIAL_RATE_DEFAULT);
+	pinMode(RADIO_SLEEP_PIN, OUTPUT);
+	digitalWrite(RADIO_SLEEP_PIN, LOW);
 	ADS7828_init();
-	protocol_createACK(ackBuf);
+	loadCalibration();
+	loadConfig();
+	applyOptions();
+	if (config_hasIdentity(&config))
+	{
+		id1 = config.id1;
+		id2 = config.id2;
+	}
+	pressure_initDetector(&bedDetector, false);
+	health_init(&health);
 	bufferPos += protocol_createYOP(buffer + bufferPos);
 	sendData(buffer, bufferPos);
 	bufferPos = 0;
-        startAT();
-        getATSH(&id1);
-        getATSL(&id2);
-        stopAT();
+	/* The radio must be configured in API mode 2 (ATAP2), its identity is queried once. */
+	if (!config_hasIdentity(&config) && xbee_getAT(PSTR("SH"), &id1, XBEE_AT_TIMEOUT) && xbee_getAT(PSTR("SL"), &id2, XBEE_AT_TIMEOUT))
+	{
+		id1 = endian_htonl(id1);
+		id2 = endian_htonl(id2);
+		config_setIdentity(&config, id1, id2);
+		saveConfig();
+	}
+	serialRate = negotiateBaudRate();
+	/* From now on the radio sleeps between bursts. */
+	xbee_setAT(PSTR("SM"), 1, 1, XBEE_AT_TIMEOUT);
+	transmit_init();
+	clock_init(&clockSync, millis());
+	telemetryTime = millis();
+	battery_init(&battery);
+	checkBattery();
+	batteryTime = millis();
 }
 
 void loop()
 {
-	
+	/* Between two sleeps or monitorings, with the stack at its lowest. */
+	if (millis() - telemetryTime >= TELEMETRY_PERIOD)
+	{
+		telemetryTime += TELEMETRY_PERIOD;
+		sendTelemetry();
+	}
+	if (millis() - batteryTime >= BATTERY_PERIOD)
+	{
+		batteryTime += BATTERY_PERIOD;
+		checkBattery();
+	}
 	old = bufferPos;
-	if (sleepMode(10000, 1000, 512, buffer, &bufferPos))
+	if (sleepMode(config.sleepTime, config.sleepDelta, buffer, &bufferPos))
 	{
-		sendData(buffer, bufferPos);
+		queueData(buffer, bufferPos, cTransmitClassRaw);
 		bufferPos = 0;
 	}
 	else if (bufferPos != old)
 	{
-		sendData(buffer, bufferPos);
+		queueData(buffer, bufferPos, cTransmitClassRaw);
 		bufferPos=0;
-		delay(1000);
+		/* Someone lies on the bed : monitor breathing. */
+		while (acquisitionMode(config.monitorTime, buffer, &bufferPos))
+		{
+			queueData(buffer, bufferPos, bRawStream ? cTransmitClassRaw : cTransmitClassSummary);
+			bufferPos = 0;
+		}
+		queueData(buffer, bufferPos, bRawStream ? cTransmitClassRaw : cTransmitClassSummary);
+		bufferPos = 0;
 	}
 	else
-		sendData(ackBuf, PROTOCOL_ACK_SIZE);
+	{
+		/* Nothing waits : an empty packet as keep alive, sent with the next burst. */
+		transmit_keepAlive();
+		pollTransmit();
+	}
 }
 
-uint8_t readSerial()
+/* State of a monitoring, shared by its tasks. */
+struct sMonitoring
 {
-  while(!Serial.available());
-  return Serial.read();
-}
+	uint8_t* buffer;
+	uint16_t* bufferPos;
+	uint16_t framePos;			/* Start of the DCN or DAN frame being extended. */
+	bool bDcnInit;
+	bool bDanInit;
+	bool bFull;
+	bool bFlush;
+	bool bStop;
+	struct sProtocolDA1 sDa1;	/* Wave of the DAN frames, holding the last FSR's sweep. */
+};
 
-bool readOK()
+/* State of a watch for a person, shared by its task. */
+struct sWatch
 {
-  	if (readSerial() != 'O')
-                return false;
-	if (readSerial() != 'K')
-		return false;
-	if (readSerial() != '\r')
-		return false;
-  return true;
-}
+	uint8_t* buffer;
+	uint16_t* bufferPos;
+	uint16_t delta;
+	uint16_t oldValues[PROTOCOL_FSR_NUMBER];
+};
 
-bool startAT()
+/* Ends the DCN or DAN frame being extended, if any. */
+void endFrame(struct sMonitoring* sMon)
 {
-  delay(2000);
-  Serial.print("+++");
-  delay(2000);
-  return readOK();
+	if (sMon->bDcnInit)
+		*sMon->bufferPos += protocol_endDCN(sMon->buffer + *sMon->bufferPos);
+	if (sMon->bDanInit)
+		*sMon->bufferPos += protocol_endDAN(sMon->buffer + *sMon->bufferPos);
+	sMon->bDcnInit = false;
+	sMon->bDanInit = false;
 }
-bool stopAT()
+
+eSchedulerResult fsrTask(void* context)
 {
-  Serial.print("ATCN\r");
-  return readOK();
+	struct sMonitoring* sMon = (struct sMonitoring*)context;
+	struct sProtocolDR1 sDr1;
+	struct sProtocolEPO sEpo;
+	uint32_t sampleStart;
+
+	/* The sample is late if the memory held the bus past its deadline. */
+	bus_sweep(scheduler_getDeadline(), millis());
+	/* Orders received while sleeping apply before the next sample. */
+	if (endMonitoring())
+	{
+		sMon->bStop = true;
+		return cSchedulerRetry;
+	}
+	/* The frame being extended has the delta of the previous period. */
+	if (bAdaptive && adaptive_apply(&adaptive))
+		endFrame(sMon);
+	sampleStart = probe_now();
+	if (bSyncStream)
+	{
+		/* Held for the DAN waves until the next sweep. */
+		getFSRSensor(sMon->sDa1.fsrValues);
+		sMon->bStop = (bedEvent(sMon->sDa1.fsrValues, platformTime()) == cProtocolEventExit);
+	}
+	else
+	{
+		endFrame(sMon);
+		if (*sMon->bufferPos + (bRawStream ? PROTOCOL_DR1_SIZE : PROTOCOL_EPO_SIZE) > BUFFER_SIZE)
+		{
+			sMon->bFull = true;
+			return cSchedulerRetry;
+		}
+		sDr1.time = platformTime();
+		getFSRSensor(sDr1.fsrValues);
+		sMon->bStop = (bedEvent(sDr1.fsrValues, sDr1.time) == cProtocolEventExit);
+		if (bRawStream)
+			*sMon->bufferPos += protocol_createDR1(&sDr1, sMon->buffer + *sMon->bufferPos);
+		else if (epoch_update(&epochAggregator, sDr1.fsrValues, sDr1.time))
+		{
+			epoch_getSummary(&epochAggregator, &sEpo);
+			*sMon->bufferPos += protocol_createEPO(&sEpo, sMon->buffer + *sMon->bufferPos);
+			sMon->bFlush = true;
+		}
+	}
+	probe_record(cProbeSample, sampleStart);
+
+	return (sMon->bStop || sMon->bFlush) ? cSchedulerLeave : cSchedulerNext;
 }
 
-bool getATSL(uint32_t* id)
+eSchedulerResult fscTask(void* context)
 {
-	bool stop = false;
-	uint8_t i = 0;
-	uint8_t j;
-	uint8_t buf;
-	uint8_t buf1[8];
+	struct sMonitoring* sMon = (struct sMonitoring*)context;
+	struct sProtocolDC1 sDc1;
+	struct sProtocolBRE sBre;
+	struct sProtocolSPC sSpc;
+	uint32_t sampleStart;
 
-        *id=0;
-	Serial.print("ATSL\r");
-	do 
+	bus_sweep(scheduler_getDeadline(), millis());
+	if (endMonitoring())
 	{
-		buf = readSerial();
-		stop = (buf == '\r');
-		if (!stop)
+		sMon->bStop = true;
+		return cSchedulerRetry;
+	}
+	sampleStart = probe_now();
+	if (bSyncStream)
+	{
+		/* A DAN frame must fit in a radio packet to be decoded on its own. */
+		if (sMon->bDanInit && *sMon->bufferPos - sMon->framePos + PROTOCOL_DAN_VAR_SIZE + PROTOCOL_FRAME_END_SIZE > TRANSMIT_PACKET_SIZE)
+			endFrame(sMon);
+		if (*sMon->bufferPos + (sMon->bDanInit ? PROTOCOL_DAN_VAR_SIZE + PROTOCOL_FRAME_END_SIZE : PROTOCOL_DAN_MIN_SIZE) > BUFFER_SIZE)
+		{
+			sMon->bFull = true;
+			return cSchedulerRetry;
+		}
+		sMon->sDa1.time = platformTime();
+		getFSCSensor(sMon->sDa1.fscValues);
+		if (bAdaptive)
+			adaptive_update(&adaptive, sMon->sDa1.fscValues);
+		if (!sMon->bDanInit)
 		{
-                        if(i > 7)
-			  return false;
-			buf1[i++] = buf;
+			sMon->framePos = *sMon->bufferPos;
+			*sMon->bufferPos += protocol_initDAN(&sMon->sDa1, (uint16_t)adaptive.fscPeriod, sMon->buffer + *sMon->bufferPos);
+			sMon->bDanInit = true;
 		}
-	} while (!stop);
-	for ( j = 0 ; j < i ; j++)
+		else
+			*sMon->bufferPos += protocol_extendDAN(sMon->sDa1.fsrValues, sMon->sDa1.fscValues, sMon->buffer + *sMon->bufferPos);
+	}
+	else if (bRawStream)
 	{
-		buf1[j] -= (isDigit(buf1[j]) ? '0' : ('A' - 10));
-        *id |= (((uint32_t) buf1[j]) << (28 - (j + (8 - i)) * 4));
+		/* A DCN frame must fit in a radio packet to be decoded on its own. */
+		if (sMon->bDcnInit && *sMon->bufferPos - sMon->framePos + PROTOCOL_DCN_VAR_SIZE + PROTOCOL_FRAME_END_SIZE > TRANSMIT_PACKET_SIZE)
+			endFrame(sMon);
+		if (*sMon->bufferPos + (sMon->bDcnInit ? PROTOCOL_DCN_VAR_SIZE + PROTOCOL_FRAME_END_SIZE : PROTOCOL_DCN_MIN_SIZE) > BUFFER_SIZE)
+		{
+			sMon->bFull = true;
+			return cSchedulerRetry;
+		}
+		sDc1.time = platformTime();
+		getFSCSensor(sDc1.fscValues);
+		if (bAdaptive)
+			adaptive_update(&adaptive, sDc1.fscValues);
+		if (!sMon->bDcnInit)
+		{
+			sMon->framePos = *sMon->bufferPos;
+			*sMon->bufferPos += protocol_initDCN(&sDc1, (uint16_t)adaptive.fscPeriod, sMon->buffer + *sMon->bufferPos);
+			sMon->bDcnInit = true;
+		}
+		else
+			*sMon->bufferPos += protocol_extendDCN(sDc1.fscValues, sMon->buffer + *sMon->bufferPos);
 	}
-	
-	*id = endian_htonl(*id);
-	return true;
+	else
+	{
+		if (*sMon->bufferPos + PROTOCOL_BRE_SIZE + PROTOCOL_SPC_SIZE > BUFFER_SIZE)
+		{
+			sMon->bFull = true;
+			return cSchedulerRetry;
+		}
+		getFSCSensor(sDc1.fscValues);
+		if (breath_update(&breathEstimator, sDc1.fscValues))
+		{
+			sBre.time = platformTime();
+			breath_getSummary(&breathEstimator, &sBre);
+			*sMon->bufferPos += protocol_createBRE(&sBre, sMon->buffer + *sMon->bufferPos);
+			/* Send the summary without waiting for a full buffer. */
+			sMon->bFlush = true;
+		}
+		if (goertzel_update(&goertzelBank, sDc1.fscValues))
+		{
+			sSpc.time = platformTime();
+			goertzel_getSpectrum(&goertzelBank, &sSpc);
+			*sMon->bufferPos += protocol_createSPC(&sSpc, sMon->buffer + *sMon->bufferPos);
+			sMon->bFlush = true;
+		}
+	}
+	probe_record(cProbeSample, sampleStart);
+
+	return sMon->bFlush ? cSchedulerLeave : cSchedulerNext;
 }
 
-bool getATSH(uint32_t* id)
+eSchedulerResult hfcTask(void* context)
 {
-        
-	bool stop = false;
-	uint8_t i = 0;
-	uint8_t j;
-	uint8_t buf;
-	uint8_t buf1[8];
+	struct sMonitoring* sMon = (struct sMonitoring*)context;
+	uint16_t fscValues[PROTOCOL_FSC_NUMBER];
+	uint32_t due;
+	uint8_t i;
 
-        *id=0;
-	Serial.print("ATSH\r");
-	do 
+	bus_sweep(scheduler_getDeadline(), millis());
+	if (endMonitoring())
 	{
-		buf = readSerial();
-		stop = (buf == '\r');
-		if (!stop)
-		{
-                        if(i > 7)
-			  return false;
-			buf1[i++] = buf;
-		}
-	} while (!stop);
-	for ( j = 0 ; j < i ; j++)
+		sMon->bStop = true;
+		return cSchedulerRetry;
+	}
+	if (*sMon->bufferPos + PROTOCOL_DCH_SIZE > BUFFER_SIZE)
 	{
-		buf1[j] -= (isDigit(buf1[j]) ? '0' : ('A' - 10));
-		*id |= (((uint32_t) buf1[j]) << (28 - (j + (8 - i)) * 4));
+		sMon->bFull = true;
+		return cSchedulerRetry;
 	}
-	
-	*id = endian_htonl(*id);
-	return true;
+	*sMon->bufferPos += protocol_initDCH(platformTime(), config.hfcPeriod, sMon->buffer + *sMon->bufferPos);
+	/* The waves are spaced in us, far below the scheduler's ms : nothing else runs meanwhile
+	   but the radio, whose ACK and NAK would overflow the serial receive buffer along the frame. */
+	due = micros();
+	for (i = 0 ; i < PROTOCOL_DCH_WAVE_NUMBER ; i++)
+	{
+		while ((int32_t)(micros() - due) < 0)
+			xbee_poll();
+		getFSCSensor(fscValues);
+		*sMon->bufferPos += protocol_extendDCH(fscValues, sMon->buffer + *sMon->bufferPos);
+		due += config.hfcPeriod;
+	}
+	*sMon->bufferPos += protocol_endDCH(sMon->buffer + *sMon->bufferPos);
+	/* A window sends its frame at once, the buffer can't hold another one. */
+	sMon->bFlush = true;
+
+	return cSchedulerLeave;
 }
 
-bool acquisitionMode(const uint32_t timeMax, const uint32_t fsrDelay, const uint32_t fscDelay, uint8_t buffer[BUFFER_SIZE], uint16_t* bufferPos)
+/* Period of the high rate windows in ms : the waves of a DCH frame, then the packets of the window through the spool,
+   the serial link and the air. A window sends its DCH frame and a DR1 frame at most, each in its own packet. */
+uint32_t hfcWindowPeriod(void)
 {
-	static uint32_t globalTimeout;
-	static uint32_t fsrTimeout;
-	static uint32_t fscTimeout;
-	static bool bStarted = false;
-	uint32_t millisSave;
-	bool bStop = false;
-	bool bFull = false;
+	const uint32_t bytes = 2 * PROTOCOL_SEQ_SIZE + PROTOCOL_DCH_SIZE + PROTOCOL_DR1_SIZE;
+	uint32_t waves;
+	uint32_t spool;
+	uint32_t serial;
+
+	waves = ((uint32_t)PROTOCOL_DCH_WAVE_NUMBER * config.hfcPeriod + 999) / 1000;
+	/* Written on two pages a packet at most, then read back by the burst. */
+	spool = (bus_getTime(2 * bytes, 2 * 2 * 3, 2 * 2) + 999) / 1000;
+	/* 10 bits a byte on the serial link. */
+	serial = ((bytes + 2 * XBEE_TX_OVERHEAD) * 10 * 1000 + serialRate - 1) / serialRate;
+
+	return waves + spool + serial + 2 * RADIO_TX_TIME;
+}
+
+eSchedulerResult watchTask(void* context)
+{
+	struct sWatch* sWatch = (struct sWatch*)context;
 	struct sProtocolDR1 sDr1;
-	struct sProtocolDC1 sDc1;
+	bool bActivity = false;
+	bool bEntry;
+	uint8_t i;
+
+	bus_sweep(scheduler_getDeadline(), millis());
+	getFSRSensor(sDr1.fsrValues);
+	bEntry = (bedEvent(sDr1.fsrValues, platformTime()) == cProtocolEventEntry);
+	i = 0;
+	do
+	{
+		bActivity = ( (((sWatch->oldValues[i] > sDr1.fsrValues[i]) ? sWatch->oldValues[i] : sDr1.fsrValues[i]) - ((sWatch->oldValues[i] < sDr1.fsrValues[i]) ? sWatch->oldValues[i] : sDr1.fsrValues[i])) >= sWatch->delta);
+		i++;
+	} while (!bActivity && i < PROTOCOL_FSR_NUMBER);
+	bActivity = bActivity || bEntry;
+	/* The platform could order a monitoring right away. */
+	if (modeRequest == cProtocolModeSleep)
+		modeRequest = cProtocolModeUnknow;
+	else if (modeRequest != cProtocolModeUnknow)
+		bActivity = true;
+	if (bActivity)
+	{
+		sDr1.time = platformTime();
+		*sWatch->bufferPos += protocol_createDR1(&sDr1, sWatch->buffer + *sWatch->bufferPos);
+	}
+	memcpy(sWatch->oldValues, sDr1.fsrValues, PROTOCOL_FSR_NUMBER * PROTOCOL_FRAME_FSR_SIZE);
+
+	return bActivity ? cSchedulerLeave : cSchedulerNext;
+}
+
+/* Tasks of a monitoring : the FSR's sweep goes first on a tie, so a DAN wave holds the sweep of its own tick.
+   Their periods are the adaptive ones, the configured ones when not adaptive. */
+const struct sSchedulerTask monitoringTasks[] PROGMEM =
+{
+	{&adaptive.fsrPeriod, 0, &fsrTask},
+	{&adaptive.fscPeriod, 0, &fscTask}
+};
+
+/* Tasks of an accurate monitoring at a high rate : FSR's sweeps between the FSC's windows. */
+const struct sSchedulerTask highRateTasks[] PROGMEM =
+{
+	{&config.fsrPeriod, 0, &fsrTask},
+	{&hfcWindow, 0, &hfcTask}
+};
 
-	assert(fsrDelay > fscDelay);
+/* Task of a watch for a person. */
+const struct sSchedulerTask watchTasks[] PROGMEM =
+{
+	{&watchPeriod, 0, &watchTask}
+};
+
+bool acquisitionMode(const uint32_t timeMax, uint8_t buffer[BUFFER_SIZE], uint16_t* bufferPos)
+{
+	static struct sScheduler sScheduler;
+	static struct sMonitoring sMon;
+
+	assert(config.fsrPeriod > config.fscPeriod);
 	assert(buffer != NULL);
 	assert(bufferPos != NULL);
 
-	if (!bStarted)
-	{
-		if (*bufferPos + PROTOCOL_DR1_SIZE + PROTOCOL_DC1_SIZE > BUFFER_SIZE)
-			bFull = true;
-		else
-		{
-			sDr1.time = sDc1.time = millisSave = millis();
-			getFSRSensor(sDr1.fsrValues);
-			
-			getFSCSensor(sDc1.fscValues);
-			*bufferPos += protocol_createDR1(&sDr1, buffer + *bufferPos);
-			*bufferPos += protocol_createDC1(&sDc1, buffer + *bufferPos);
-			bStarted = true;
-			globalTimeout   = millisSave + timeMax;
-			fsrTimeout      = millisSave + fsrDelay;
-			fscTimeout      = millisSave + fscTimeout;
-			bStop = mysleep(fscDelay, globalTimeout);
-
-		}
-	}
-	if (bStarted)
+	if (!bMonitoring)
 	{
-		bool bDcnInit = false;
-		do
-		{
-			if (fscTimeout > fsrTimeout)
-			{
-				if (bDcnInit)
-				{
-					*bufferPos = protocol_endDCN(buffer + *bufferPos);
-					bDcnInit = false;
-				}
-				if (*bufferPos + PROTOCOL_DR1_SIZE > BUFFER_SIZE)
-					bFull = true;
-				else
-				{
-					sDr1.time = millis();
-					getFSRSensor(sDr1.fsrValues);
-					*bufferPos += protocol_createDR1(&sDr1, buffer + *bufferPos);
-					fsrTimeout += fsrDelay;
-				}
-			}
-			else
-			{
-				if (!bDcnInit)
-				{
-					// if (!(bFull = (*bufferPos + PROTOCOL_DCN_MIN_SIZE > BUFFER_SIZE)))
-					if (*bufferPos + PROTOCOL_DCN_MIN_SIZE > BUFFER_SIZE)
-						bFull = true;
-					else
-					{
-						sDc1.time = millis();
-						getFSCSensor(sDc1.fscValues);
-						*bufferPos += protocol_initDCN(&sDc1, fscDelay, buffer + *bufferPos);
-						bDcnInit = true;
-					}
-				}
-				else
-				{
-					if (*bufferPos + PROTOCOL_DCN_VAR_SIZE + PROTOCOL_FRAME_END_SIZE > BUFFER_SIZE)
-					bFull = true;
-					else
-					{
-						getFSCSensor(sDc1.fscValues);
-						*bufferPos += protocol_extendDCN(sDc1.fscValues, buffer + *bufferPos);
-					}
-				}
-				// fscTimeout += !bFull * fscDelay;
-				if (!bFull)
-					fscTimeout += fscDelay;
-				
-			}
-			if (!bFull)
-			{
-				millisSave = millis();
-				if (millisSave > globalTimeout)
-					bStop = true;
-				else if ((millisSave < fscTimeout) && (millisSave < fsrTimeout))
-					bStop = mysleep(((fscTimeout < fsrTimeout) ? fscTimeout : fsrTimeout) - millisSave, globalTimeout);
-			}
-		} while (!bFull && !bStop);
-		if (bDcnInit)
+		/* The platform chooses the resolution of the next monitoring. */
+		if (modeRequest == cProtocolModeNormal || modeRequest == cProtocolModeAccurate)
 		{
-			*bufferPos = protocol_endDCN(buffer + *bufferPos);
-			bDcnInit = false;
+			bRawStream = (modeRequest == cProtocolModeAccurate);
+			modeRequest = cProtocolModeUnknow;
 		}
-		if (bStarted && bStop)
-		bStarted = false;
+		/* A change of the options applies from the next monitoring, as a change of the battery's profile. */
+		bLowProfile = battery_isLow(&battery);
+		bHighRate = bRawStream && !bLowProfile && (config.hfcPeriod != 0);
+		bSyncStream = bRawStream && !bHighRate && (config.options & CONFIG_OPTION_SYNC) && (config.fsrPeriod % config.fscPeriod == 0);
+		/* The breathing summaries need a steady period. */
+		bAdaptive = bRawStream && !bHighRate && !bLowProfile && (config.options & CONFIG_OPTION_ADAPTIVE);
+		hfcWindow = hfcWindowPeriod();
+		/* The low power profile stretches the sweeps, and the raw waves within the 16 bits delta of their frames :
+		   the breathing estimators need the configured FSC's period. */
+		if (bLowProfile)
+			adaptive_init(&adaptive, config.fsrPeriod << BATTERY_LOW_SHIFT,
+				(bRawStream && config.fscPeriod <= (UINT16_MAX >> BATTERY_LOW_SHIFT)) ? config.fscPeriod << BATTERY_LOW_SHIFT : config.fscPeriod);
+		else
+			adaptive_init(&adaptive, config.fsrPeriod, config.fscPeriod);
+		breath_init(&breathEstimator, config.fscPeriod);
+		/* The spectrum's bins are computed for the default FSC's period only. */
+		goertzel_init(&goertzelBank, config.fscPeriod);
+		epoch_init(&epochAggregator);
+		bMonitoring = true;
+		/* Both sensors sampled at once, then each at its own period. */
+		if (bHighRate)
+			scheduler_start(&sScheduler, highRateTasks, sizeof(highRateTasks) / sizeof(highRateTasks[0]), timeMax);
+		else
+			scheduler_start(&sScheduler, monitoringTasks, sizeof(monitoringTasks) / sizeof(monitoringTasks[0]), timeMax);
 	}
+	sMon.buffer = buffer;
+	sMon.bufferPos = bufferPos;
+	sMon.bDcnInit = false;
+	sMon.bDanInit = false;
+	sMon.bFull = false;
+	sMon.bFlush = false;
+	sMon.bStop = !scheduler_run(&sScheduler, &sMon) || sMon.bStop;
+	endFrame(&sMon);
+	if (sMon.bStop)
+		bMonitoring = false;
+	if (sMon.bFull)
+		probe_count(cProbeCounterFull);
 
-	return bFull;
+	/* A stopped monitoring isn't started again by the caller. */
+	return (sMon.bFull || sMon.bFlush) && bMonitoring;
 }
 
-uint8_t sleepMode(const uint32_t timeMax, const uint32_t delay, const uint16_t delta, uint8_t buffer[BUFFER_SIZE], uint16_t* bufferPos)
+uint8_t sleepMode(const uint32_t timeMax, const uint16_t delta, uint8_t buffer[BUFFER_SIZE], uint16_t* bufferPos)
 {
-	uint32_t timeout = timeMax + millis();
 	static bool bFirst = true;
-	static uint16_t oldValues[PROTOCOL_FSR_NUMBER];
+	static struct sWatch sWatch;
+	struct sScheduler sScheduler;
 	bool bFull = false;
-	bool bStop = false;
-	bool bActivity = false;
-	uint8_t i;
-	struct sProtocolDR1 sDr1;
-	
+
 	assert(delta < 4096);
-	
+
 	if (bFirst)
 	{
-		getFSRSensor(oldValues);
+		getFSRSensor(sWatch.oldValues);
 		bFirst = false;
 	}
 	if (*bufferPos + PROTOCOL_DR1_SIZE > BUFFER_SIZE)
-	bFull = true;
+	{
+		bFull = true;
+		probe_count(cProbeCounterFull);
+	}
 	else
 	{
-		bActivity = false;
-		do {
-			getFSRSensor(sDr1.fsrValues);
-			i = 0;
-			do
-			{
-				bActivity = ( (((oldValues[i] > sDr1.fsrValues[i]) ? oldValues[i] : sDr1.fsrValues[i]) - ((oldValues[i] < sDr1.fsrValues[i]) ? oldValues[i] : sDr1.fsrValues[i])) >= delta);
-				i++;
-			} while (!bActivity && i < PROTOCOL_FSR_NUMBER);
-			if (bActivity)
-			{
-				
-				sDr1.time = millis();
-				*bufferPos += protocol_createDR1(&sDr1, buffer + *bufferPos);
-			}
-			else
-			{
-				bStop = mysleep(delay, timeout);
-			}
-			memcpy(oldValues, sDr1.fsrValues, PROTOCOL_FSR_NUMBER * PROTOCOL_FRAME_FSR_SIZE);
-		} while (!bStop && !bActivity);
+		sWatch.buffer = buffer;
+		sWatch.bufferPos = bufferPos;
+		sWatch.delta = delta;
+		/* A low battery sweeps less often while nobody lies. */
+		watchPeriod = config.sleepPeriod << (battery_isLow(&battery) ? BATTERY_LOW_SHIFT : 0);
+		scheduler_start(&sScheduler, watchTasks, sizeof(watchTasks) / sizeof(watchTasks[0]), timeMax);
+		scheduler_run(&sScheduler, &sWatch);
 	}
 
 	return bFull;
@@ -349,7 +1091,23 @@ bool mysleep(uint32_t time, uint32_t timeout)
 	bool ret;
 	uint32_t timeoutDelay = timeout - millis();
 	uint32_t ref = (ret = (timeoutDelay < time)) ? timeoutDelay : time;
-	delay(ref);
+	uint32_t end = millis() + ref;
+	uint32_t wait;
+
+	/* The ADC sweeps at the end of the sleep, the spool waits for the next one. */
+	bus_reserve(end);
+	/* Bursts falling due during the sleep are sent on time. */
+	while ((wait = end - millis()) > 0 && wait <= ref)
+	{
+		pollCommands();
+		pollTransmit();
+		if (wait > transmit_getDelay())
+			wait = transmit_getDelay();
+		/* Commands are handled within a slice, not at the next sample. */
+		if (wait > COMMAND_POLL_PERIOD)
+			wait = COMMAND_POLL_PERIOD;
+		delay(wait);
+	}
 
 	return ret;
 }
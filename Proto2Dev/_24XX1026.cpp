@@ -14,6 +14,7 @@
 
 uint8_t _24XX1026_writePage(const uint8_t i2cAddr, const uint8_t block_id, uint16_t writeAddr, uint8_t const* data, const uint16_t nbData)
 {
+    uint8_t ret;
     uint16_t i;
     
     assert(i2cAddr < 4);
@@ -45,7 +46,12 @@ uint8_t _24XX1026_writePage(const uint8_t i2cAddr, const uint8_t block_id, uint1
         Wire.write(data[i]);
     }
     
-    return Wire.endTransmission(true);		
+    ret = Wire.endTransmission(true);
+    if (ret != TWI_SUCCESS)
+        return ret;
+    
+    // The memory ignores any access until the end of its write cycle.
+    return _24XX1026_waitReady(i2cAddr, block_id);
 }
 
 inline uint8_t _24XX1026_writeByte(const uint8_t i2cAddr, const uint8_t block_id, uint16_t writeAddr, const uint8_t data)
@@ -53,9 +59,29 @@ inline uint8_t _24XX1026_writeByte(const uint8_t i2cAddr, const uint8_t block_id
     return _24XX1026_writePage(i2cAddr, block_id, writeAddr, &data, 1);
 }
 
-uint8_t _24XX1026_readSequential(const uint8_t i2cAddr, const uint8_t block_id, uint16_t const* readAddr, uint8_t* values, const uint16_t nbValue)
+uint8_t _24XX1026_waitReady(const uint8_t i2cAddr, const uint8_t block_id)
 {
     uint8_t ret;
+    uint32_t start;
+    
+    assert(i2cAddr < 4);
+    assert(block_id < _24XX1026_NB_BLOC);
+    
+    start = millis();
+    do
+    {
+        // Acknowledge polling : a control byte alone, acknowledged once the write cycle is over.
+        Wire.beginTransmission((_24XX1026_HARDWARE_ADDRESS << 3) | (i2cAddr << 1) | block_id);
+        ret = Wire.endTransmission(true);
+    }
+    while (ret == TWI_NACK_ON_ADDRESS && millis() - start < _24XX1026_WRITE_CYCLE_TIMEOUT);
+    
+    return ret;
+}
+
+uint8_t _24XX1026_readSequential(const uint8_t i2cAddr, const uint8_t block_id, uint16_t const* readAddr, uint8_t* values, const uint16_t nbValue)
+{
+    uint8_t ret = TWI_SUCCESS;
     int addr;
     uint16_t remainingValues;
     uint16_t readValues;
@@ -67,6 +93,11 @@ uint8_t _24XX1026_readSequential(const uint8_t i2cAddr, const uint8_t block_id,
     
     addr = (int)(_24XX1026_HARDWARE_ADDRESS << 3) | (i2cAddr << 1) | block_id;
     
+    // The last write cycle may still be under way if its wait timed out.
+    ret = _24XX1026_waitReady(i2cAddr, block_id);
+    if (ret != TWI_SUCCESS)
+        return ret;
+    
     if (readAddr != NULL)
     {
         /* Write Byte :
@@ -47,6 +47,13 @@
   */
  #define _24XX1026_PAGE_SIZE            128
 
+ /**
+  *	Longest time waited for the end of a write cycle in ms.
+  *
+  *	@note The data sheet gives 5 ms at most.
+  */
+ #define _24XX1026_WRITE_CYCLE_TIMEOUT  10
+
  /**
   *	Size of TWI buffer required by 24XX1026 to work.
   */
@@ -160,7 +167,10 @@
   *         - TWI_NACK_ON_DATA
   *         - TWI_OTHER_ERROR
   * 
+  * @note Returns at the end of the write cycle, so the memory is ready for the next access.
+  * 
   * @see _24XX1026_writeByte()
+  * @see _24XX1026_waitReady()
   */
         uint8_t _24XX1026_writePage(         const uint8_t i2cAddr, const uint8_t block_id, uint16_t writeAddr, uint8_t const* data, const uint16_t nbData);
 
@@ -187,6 +197,28 @@
   */
 inline  uint8_t _24XX1026_writeByte(         const uint8_t i2cAddr, const uint8_t block_id, uint16_t writeAddr, const uint8_t data);
 
+ /**
+  * Waits for the end of the write cycle of the memory.
+  * 
+  * Extract from data sheet <a href="http://ww1.microchip.com/downloads/en/DeviceDoc/20002270D.pdf">acknowledge polling section</a> :
+  * 
+  * > Since the device will not acknowledge
+  * > during a write cycle, this can be used to
+  * > determine when the cycle is complete.
+  * 
+  * @param [in] i2cAddr
+  *     24XX1026's I2C address on the bus [0;4[.
+  * @param [in] block_id
+  *     Identifier of the block last written [0;_24XX1026_NB_BLOC[.
+  * 
+  * @return TWI_SUCCESS, if the memory is ready, else an error among
+  *         - TWI_NACK_ON_ADDRESS, still busy after _24XX1026_WRITE_CYCLE_TIMEOUT
+  *         - TWI_OTHER_ERROR
+  * 
+  * @see _24XX1026_writePage()
+  */
+        uint8_t _24XX1026_waitReady(         const uint8_t i2cAddr, const uint8_t block_id);
+
  /**
   * Reads up to one block of memory.
   * 
@@ -0,0 +1,120 @@
+/**
+ *  @copybrief adaptive.h
+ *  @copydetails adaptive.h
+ *
+ *  @file adaptive.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "adaptive.h"
+
+/**
+ *	Scales a configured period to a level.
+ *
+ *  @internal
+ *
+ *  @param [in] base
+ *      The configured period in ms.
+ *  @param [in] level
+ *      The level.
+ *
+ *  @return The period in ms, 0 if out of range.
+ */
+static uint32_t adaptive_scale(const uint32_t base, const int8_t level);
+
+static uint32_t adaptive_scale(const uint32_t base, const int8_t level)
+{
+    if (level >= 0)
+        return (base > (UINT32_MAX >> level)) ? 0 : base << level;
+
+    return base >> -level;
+}
+
+void adaptive_init(struct sAdaptive* sAdaptive, const uint32_t fsrPeriod, const uint32_t fscPeriod)
+{
+    assert(sAdaptive != NULL);
+    assert(fscPeriod > 0 && fsrPeriod > fscPeriod);
+
+    memset(sAdaptive, 0, sizeof(*sAdaptive));
+    sAdaptive->fsrPeriod = sAdaptive->fsrBase = fsrPeriod;
+    sAdaptive->fscPeriod = sAdaptive->fscBase = fscPeriod;
+    sAdaptive->hold = ADAPTIVE_HOLD;
+    sAdaptive->warmup = 1 << ADAPTIVE_LONG_SHIFT;
+}
+
+void adaptive_update(struct sAdaptive* sAdaptive, uint16_t const fscValues[PROTOCOL_FSC_NUMBER])
+{
+    uint8_t iter;
+    int32_t value;
+    int32_t deviation;
+
+    assert(sAdaptive != NULL);
+    assert(fscValues != NULL);
+
+    value = 0;
+    for (iter = 0 ; iter < PROTOCOL_FSC_NUMBER ; iter++)
+        value += fscValues[iter];
+    if (sAdaptive->warmup == 1 << ADAPTIVE_LONG_SHIFT)
+        sAdaptive->mean = value << 4;
+    sAdaptive->mean += ((value << 4) - sAdaptive->mean) >> ADAPTIVE_SHORT_SHIFT;
+    deviation = value - (sAdaptive->mean >> 4);
+    deviation *= deviation;
+    sAdaptive->varShort += (deviation - sAdaptive->varShort) >> ADAPTIVE_SHORT_SHIFT;
+    sAdaptive->varLong  += (deviation - sAdaptive->varLong) >> ADAPTIVE_LONG_SHIFT;
+
+    /* The long window is filled before any decision. */
+    if (sAdaptive->warmup > 0)
+    {
+        sAdaptive->warmup--;
+        return;
+    }
+    if (sAdaptive->hold > 0)
+        sAdaptive->hold--;
+    if (sAdaptive->varShort / ADAPTIVE_BURST_RATIO > sAdaptive->varLong)
+    {
+        /* A movement : as fast as possible at once. */
+        sAdaptive->target = ADAPTIVE_LEVEL_MIN;
+        sAdaptive->hold = ADAPTIVE_HOLD;
+    }
+    else if (sAdaptive->varShort / ADAPTIVE_STEADY_RATIO > sAdaptive->varLong)
+        sAdaptive->hold = ADAPTIVE_HOLD;
+    else if (sAdaptive->hold == 0 && sAdaptive->target < ADAPTIVE_LEVEL_MAX)
+    {
+        /* A stable breathing : one level slower. */
+        sAdaptive->target++;
+        sAdaptive->hold = ADAPTIVE_HOLD;
+    }
+}
+
+bool adaptive_apply(struct sAdaptive* sAdaptive)
+{
+    uint32_t fscPeriod;
+    uint32_t fsrPeriod;
+
+    assert(sAdaptive != NULL);
+
+    if (sAdaptive->target == sAdaptive->level)
+        return false;
+
+    fscPeriod = adaptive_scale(sAdaptive->fscBase, sAdaptive->target);
+    /* The FSR's sweeps stay on the FSC's ticks. */
+    if (sAdaptive->fsrBase % sAdaptive->fscBase == 0)
+        fsrPeriod = fscPeriod * (sAdaptive->fsrBase / sAdaptive->fscBase);
+    else
+        fsrPeriod = adaptive_scale(sAdaptive->fsrBase, sAdaptive->target);
+    /* Sent as the 16 bits delta of the DCN frames. */
+    if (fscPeriod == 0 || fscPeriod > UINT16_MAX || fsrPeriod <= fscPeriod)
+    {
+        sAdaptive->target = sAdaptive->level;
+        return false;
+    }
+    sAdaptive->level = sAdaptive->target;
+    sAdaptive->fscPeriod = fscPeriod;
+    sAdaptive->fsrPeriod = fsrPeriod;
+
+    return true;
+}
@@ -0,0 +1,118 @@
+/**
+ *  Adaptive sampling periods of the monitorings.
+ *
+ *  The variance of the FSC's waves is followed over a short and a long
+ *  window. A short variance far above the long one is a movement : the
+ *  periods drop to their fastest level at once. A short variance steady
+ *  around the long one is a stable breathing : every ADAPTIVE_HOLD waves
+ *  the periods go one level slower, up to the slowest one. Both windows
+ *  being relative to the signal itself, no threshold depends on the load
+ *  or on the calibration.
+ *
+ *  The level is applied at the FSR's sweeps only, so the FSR and the FSC
+ *  keep sampling on the same ticks, and the ratio between both periods is
+ *  kept. A new period starts a new DCN or DAN frame : its delta marks the
+ *  change for the platform.
+ *
+ *  @file adaptive.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef ADAPTIVE_H
+ #define ADAPTIVE_H
+
+ #include <inttypes.h>
+ #include <string.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+
+ /**
+  *	Short and long windows of the variance, as powers of two of waves.
+  */
+ #define ADAPTIVE_SHORT_SHIFT       3
+ #define ADAPTIVE_LONG_SHIFT        7
+ /**
+  *	Ratio of the short variance to the long one revealing a movement.
+  */
+ #define ADAPTIVE_BURST_RATIO       4
+ /**
+  *	Ratio of the short variance to the long one below which the breathing is steady.
+  */
+ #define ADAPTIVE_STEADY_RATIO      2
+ /**
+  *	Number of steady waves before going one level slower.
+  */
+ #define ADAPTIVE_HOLD              64
+ /**
+  *	Fastest and slowest levels, the periods being the configured ones times 2^level.
+  */
+ #define ADAPTIVE_LEVEL_MIN         (-1)
+ #define ADAPTIVE_LEVEL_MAX         1
+
+ /**
+  *	State of the controller.
+  */
+ struct sAdaptive
+ {
+    uint32_t fsrPeriod;     /**< Period of the FSR's sweeps in use in ms. */
+    uint32_t fscPeriod;     /**< Period of the FSC's waves in use in ms. */
+    uint32_t fsrBase;       /**< Configured period of the FSR's sweeps in ms. */
+    uint32_t fscBase;       /**< Configured period of the FSC's waves in ms. */
+    int32_t  mean;          /**< Mean of the FSC's waves over the short window, in 2^-4. */
+    int32_t  varShort;      /**< Variance over the short window. */
+    int32_t  varLong;       /**< Variance over the long window. */
+    uint16_t hold;          /**< Steady waves left before going slower. */
+    uint8_t  warmup;        /**< Waves left to fill the long window. */
+    int8_t   level;         /**< Level in use. */
+    int8_t   target;        /**< Level applied at the next FSR's sweep. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Starts at the configured periods.
+  *
+  *  @param [out] sAdaptive
+  *      Reference to the state.
+  *  @param [in] fsrPeriod
+  *      Configured period of the FSR's sweeps in ms.
+  *  @param [in] fscPeriod
+  *      Configured period of the FSC's waves in ms.
+  */
+ void adaptive_init(struct sAdaptive* sAdaptive, const uint32_t fsrPeriod, const uint32_t fscPeriod);
+
+ /**
+  *	Takes a wave of the FSC into account.
+  *
+  *  @param [in,out] sAdaptive
+  *      Reference to the state.
+  *  @param [in] fscValues
+  *      The wave.
+  */
+ void adaptive_update(struct sAdaptive* sAdaptive, uint16_t const fscValues[PROTOCOL_FSC_NUMBER]);
+
+ /**
+  *	Applies the level chosen, at a sweep of the FSR.
+  *
+  *  @param [in,out] sAdaptive
+  *      Reference to the state.
+  *
+  *  @return true if the periods have changed, false otherwise.
+  */
+ bool adaptive_apply(struct sAdaptive* sAdaptive);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,95 @@
+/**
+ *  @copybrief battery.h
+ *  @copydetails battery.h
+ *
+ *  @file battery.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "battery.h"
+
+/**
+ *	Computes the charge of the filtered voltage.
+ *
+ *  @internal
+ *
+ *  @param [in] sBattery
+ *      Reference to the state.
+ *
+ *  @return The charge in %, linear between the empty and the full voltages.
+ */
+static uint8_t battery_charge(struct sBattery const* sBattery);
+
+static uint8_t battery_charge(struct sBattery const* sBattery)
+{
+    uint32_t voltage;
+
+    voltage = sBattery->voltage >> 4;
+    if (voltage <= BATTERY_EMPTY_VOLTAGE)
+        return 0;
+    if (voltage >= BATTERY_FULL_VOLTAGE)
+        return 100;
+
+    return (uint8_t)((voltage - BATTERY_EMPTY_VOLTAGE) * 100 / (BATTERY_FULL_VOLTAGE - BATTERY_EMPTY_VOLTAGE));
+}
+
+void battery_init(struct sBattery* sBattery)
+{
+    assert(sBattery != NULL);
+
+    memset(sBattery, 0, sizeof(*sBattery));
+    sBattery->bReport = true;
+}
+
+bool battery_update(struct sBattery* sBattery, const uint16_t voltage, const uint32_t now)
+{
+    uint8_t charge;
+    uint8_t change;
+
+    assert(sBattery != NULL);
+
+    /* A failed measurement keeps the last state. */
+    if (voltage == 0)
+        return false;
+    if (sBattery->voltage == 0)
+        sBattery->voltage = (uint32_t)voltage << 4;
+    else
+        sBattery->voltage += (((int32_t)voltage << 4) - (int32_t)sBattery->voltage) >> BATTERY_FILTER_SHIFT;
+
+    charge = battery_charge(sBattery);
+    if (!sBattery->bLow && charge < BATTERY_LOW_CHARGE)
+        sBattery->bLow = sBattery->bReport = true;
+    else if (sBattery->bLow && charge >= BATTERY_HIGH_CHARGE)
+    {
+        sBattery->bLow = false;
+        sBattery->bReport = true;
+    }
+    change = (charge > sBattery->reported) ? charge - sBattery->reported : sBattery->reported - charge;
+    if (change >= BATTERY_REPORT_STEP || now - sBattery->reportTime >= BATTERY_REPORT_PERIOD)
+        sBattery->bReport = true;
+
+    return sBattery->bReport;
+}
+
+void battery_getReport(struct sBattery* sBattery, struct sProtocolBAT* sBat, const uint32_t now)
+{
+    assert(sBattery != NULL);
+    assert(sBat != NULL);
+
+    sBat->voltage = (uint16_t)(sBattery->voltage >> 4);
+    sBat->charge = battery_charge(sBattery);
+    sBattery->reported = sBat->charge;
+    sBattery->reportTime = now;
+    sBattery->bReport = false;
+}
+
+bool battery_isLow(struct sBattery const* sBattery)
+{
+    assert(sBattery != NULL);
+
+    return sBattery->bLow;
+}
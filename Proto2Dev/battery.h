@@ -0,0 +1,137 @@
+/**
+ *  Bed sensor's battery monitoring.
+ *
+ *  The supply voltage is measured once every BATTERY_PERIOD, between two
+ *  modes, and filtered in fixed point. It's the battery's voltage only if
+ *  the cell feeds the board directly, without any regulator. Its charge is reported by a BAT
+ *  frame when it changed by BATTERY_REPORT_STEP, when the battery gets low
+ *  or recovers, and at least every BATTERY_REPORT_PERIOD. Below
+ *  BATTERY_LOW_CHARGE the bed sensor runs a low power profile until the
+ *  charge comes back above BATTERY_HIGH_CHARGE.
+ *
+ *  @file battery.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef BATTERY_H
+ #define BATTERY_H
+
+ #include <inttypes.h>
+ #include <string.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+
+ /**
+  *	Period of the measurements in ms.
+  */
+ #define BATTERY_PERIOD             60000
+ /**
+  *	Weight of a measurement in the filter, as a power of two.
+  */
+ #define BATTERY_FILTER_SHIFT       3
+ /**
+  *	Voltages of a full and of an empty battery in mV.
+  *
+  *  @note The radio stops below 2.8 V.
+  *  @warning The measure is the MCU's supply (AVcc) : it follows the cell only
+  *      if the cell feeds Vcc directly. Behind a regulator it stays at the
+  *      regulated voltage until dropout, so these bounds must be redefined
+  *      for that board, or the cell measured through a divider instead.
+  */
+ #ifndef BATTERY_FULL_VOLTAGE
+  #define BATTERY_FULL_VOLTAGE      3300
+ #endif
+ #ifndef BATTERY_EMPTY_VOLTAGE
+  #define BATTERY_EMPTY_VOLTAGE     2800
+ #endif
+ /**
+  *	Charges entering and leaving the low power profile in %.
+  */
+ #define BATTERY_LOW_CHARGE         20
+ #define BATTERY_HIGH_CHARGE        25
+ /**
+  *	Change of charge reported at once in %.
+  */
+ #define BATTERY_REPORT_STEP        5
+ /**
+  *	Longest time between two reports in ms.
+  */
+ #define BATTERY_REPORT_PERIOD      3600000
+ /**
+  *	Stretch of the periods of the low power profile, as a power of two.
+  */
+ #define BATTERY_LOW_SHIFT          1
+
+ /**
+  *	State of the monitoring.
+  */
+ struct sBattery
+ {
+    uint32_t voltage;       /**< Filtered voltage in 2^-4 mV, 0 before the first measurement. */
+    uint32_t reportTime;    /**< Time of the last report in ms. */
+    uint8_t  reported;      /**< Charge of the last report in %. */
+    bool     bLow;          /**< The low power profile is running. */
+    bool     bReport;       /**< A report is due. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Starts without any measurement, the first one being reported.
+  *
+  *  @param [out] sBattery
+  *      Reference to the state.
+  */
+ void battery_init(struct sBattery* sBattery);
+
+ /**
+  *	Takes a measurement into account.
+  *
+  *  @param [in,out] sBattery
+  *      Reference to the state.
+  *  @param [in] voltage
+  *      The supply voltage in mV, 0 if unknown.
+  *  @param [in] now
+  *      Current time in ms.
+  *
+  *  @return true if a BAT frame is due, false otherwise.
+  */
+ bool battery_update(struct sBattery* sBattery, const uint16_t voltage, const uint32_t now);
+
+ /**
+  *	Gives the content of a BAT frame and marks it as reported.
+  *
+  *  @param [in,out] sBattery
+  *      Reference to the state.
+  *  @param [out] sBat
+  *      Reference to the container, its time left to the caller.
+  *  @param [in] now
+  *      Current time in ms.
+  */
+ void battery_getReport(struct sBattery* sBattery, struct sProtocolBAT* sBat, const uint32_t now);
+
+ /**
+  *	Determines if the low power profile must run.
+  *
+  *  @param [in] sBattery
+  *      Reference to the state.
+  *
+  *  @return true if the battery is low, false otherwise.
+  */
+ bool battery_isLow(struct sBattery const* sBattery);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,141 @@
+/**
+ *  @copybrief breath.h
+ *  @copydetails breath.h
+ *
+ *  @file breath.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "breath.h"
+
+/**
+ *	Starts a new analysis window.
+ *
+ *  @internal
+ *
+ *  @param [in,out] sBreath
+ *      Reference to the estimator.
+ */
+static void breath_resetWindow(struct sBreathEstimator* sBreath);
+
+static void breath_resetWindow(struct sBreathEstimator* sBreath)
+{
+    sBreath->max          = INT32_MIN;
+    sBreath->min          = INT32_MAX;
+    sBreath->sumDeviation = 0;
+    sBreath->nbSamples    = 0;
+    sBreath->nbCycles     = 0;
+    sBreath->firstCycle   = 0;
+    sBreath->lastCycle    = 0;
+}
+
+void breath_init(struct sBreathEstimator* sBreath, const uint16_t delta)
+{
+    assert(sBreath != NULL);
+    assert(delta != 0);
+
+    sBreath->fast       = 0;
+    sBreath->slow       = 0;
+    sBreath->delta      = delta;
+    sBreath->lastLength = 0;
+    sBreath->bPositive  = false;
+    sBreath->bPrimed    = false;
+
+    breath_resetWindow(sBreath);
+}
+
+bool breath_update(struct sBreathEstimator* sBreath, uint16_t const fscValues[PROTOCOL_FSC_NUMBER])
+{
+    int32_t value;
+    int32_t band;
+    uint16_t length;
+    uint8_t iterFsc;
+
+    assert(sBreath != NULL);
+    assert(fscValues != NULL);
+
+    value = 0;
+    for (iterFsc = 0 ; iterFsc < PROTOCOL_FSC_NUMBER ; iterFsc++)
+        value += fscValues[iterFsc];
+    value <<= BREATH_FRACTION_BITS;
+
+    if (!sBreath->bPrimed)
+    {
+        /* Avoid the step response of the filters at startup. */
+        sBreath->fast = sBreath->slow = value;
+        sBreath->bPrimed = true;
+    }
+    sBreath->fast += (value - sBreath->fast) >> BREATH_FAST_SHIFT;
+    sBreath->slow += (value - sBreath->slow) >> BREATH_SLOW_SHIFT;
+    band = sBreath->fast - sBreath->slow;
+
+    if (band > sBreath->max)
+        sBreath->max = band;
+    if (band < sBreath->min)
+        sBreath->min = band;
+
+    if (!sBreath->bPositive && band > BREATH_HYSTERESIS)
+    {
+        /* Start of an inspiration. */
+        sBreath->bPositive = true;
+        if (sBreath->nbCycles == 0)
+            sBreath->firstCycle = sBreath->nbSamples;
+        else
+        {
+            length = sBreath->nbSamples - sBreath->lastCycle;
+            if (sBreath->nbCycles > 1)
+                sBreath->sumDeviation += (length > sBreath->lastLength) ? length - sBreath->lastLength : sBreath->lastLength - length;
+            sBreath->lastLength = length;
+        }
+        sBreath->lastCycle = sBreath->nbSamples;
+        sBreath->nbCycles++;
+    }
+    else if (sBreath->bPositive && band < -BREATH_HYSTERESIS)
+        sBreath->bPositive = false;
+
+    sBreath->nbSamples++;
+
+    return (sBreath->nbSamples >= BREATH_WINDOW_SAMPLES);
+}
+
+void breath_getSummary(struct sBreathEstimator* sBreath, struct sProtocolBRE* sBre)
+{
+    uint32_t span;
+    uint32_t meanLength;
+    uint32_t deviation;
+    int32_t  amplitude;
+
+    assert(sBreath != NULL);
+    assert(sBre != NULL);
+
+    sBre->rate       = 0;
+    sBre->amplitude  = 0;
+    sBre->confidence = 0;
+
+    if (sBreath->nbSamples > 0)
+    {
+        amplitude = (sBreath->max - sBreath->min) >> BREATH_FRACTION_BITS;
+        sBre->amplitude = (amplitude > UINT16_MAX) ? UINT16_MAX : amplitude;
+    }
+
+    if (sBreath->nbCycles >= 2)
+    {
+        /* Rate from the mean length of complete cycles, in 1/10 breaths per minute. */
+        span = (uint32_t)(sBreath->lastCycle - sBreath->firstCycle) * sBreath->delta;
+        sBre->rate = ((uint32_t)(sBreath->nbCycles - 1) * 600000UL) / span;
+
+        if (sBreath->nbCycles >= 3)
+        {
+            /* Confidence decreases with the cycle to cycle variability. */
+            meanLength = (sBreath->lastCycle - sBreath->firstCycle) / (sBreath->nbCycles - 1);
+            deviation  = (sBreath->sumDeviation * 255UL) / ((uint32_t)(sBreath->nbCycles - 2) * meanLength);
+            sBre->confidence = (deviation > 255) ? 0 : 255 - deviation;
+        }
+    }
+
+    breath_resetWindow(sBreath);
+}
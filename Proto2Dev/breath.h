@@ -0,0 +1,126 @@
+/**
+ *  Bed sensor's breathing rate estimator.
+ *
+ *  Streaming estimation of the breathing rate from the FSC's sampling
+ *  waves. The signal is band-passed by two fixed-point exponential
+ *  filters, then breathing cycles are counted with an hysteresis
+ *  zero-crossing detector over an analysis window.
+ *
+ *  Only integer arithmetic is used so the same source gives bit-exact
+ *  results on the bed sensor and on a host (gateway, archives replay).
+ *
+ *  @file breath.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef BREATH_H
+ #define BREATH_H
+
+ #include <inttypes.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+
+ /**
+  *	Number of fractional bits of the filtered signal.
+  */
+ #define BREATH_FRACTION_BITS       8
+ /**
+  *	Shift of the fast exponential filter (low-pass part of the band-pass).
+  *
+  *  @note The time constant is 2^BREATH_FAST_SHIFT sampling waves.
+  *        With a sampling period of 100 ms, cutoff is around 0.8 Hz.
+  */
+ #define BREATH_FAST_SHIFT          1
+ /**
+  *	Shift of the slow exponential filter (high-pass part of the band-pass).
+  *
+  *  @note The time constant is 2^BREATH_SLOW_SHIFT sampling waves.
+  *        With a sampling period of 100 ms, cutoff is around 0.05 Hz.
+  */
+ #define BREATH_SLOW_SHIFT          5
+ /**
+  *	Hysteresis of the zero-crossing detector in filtered signal units.
+  */
+ #define BREATH_HYSTERESIS          (2 << (BREATH_FRACTION_BITS))
+ /**
+  *	Number of sampling waves in an analysis window.
+  */
+ #define BREATH_WINDOW_SAMPLES      300
+
+ /**
+  *	State of a breathing rate estimator.
+  *
+  *  @note The memory footprint doesn't depend on the window length.
+  */
+ struct sBreathEstimator
+ {
+    int32_t  fast;          /**< Fast exponential filter state. */
+    int32_t  slow;          /**< Slow exponential filter state. */
+    int32_t  max;           /**< Maximum of the band-passed signal in the window. */
+    int32_t  min;           /**< Minimum of the band-passed signal in the window. */
+    uint32_t sumDeviation;  /**< Sum of the differences between consecutive cycles lengths. */
+    uint16_t delta;         /**< Time between two sampling waves in ms. */
+    uint16_t nbSamples;     /**< Number of sampling waves in the current window. */
+    uint16_t nbCycles;      /**< Number of cycles starts in the current window. */
+    uint16_t firstCycle;    /**< Index of the first cycle start in the window. */
+    uint16_t lastCycle;     /**< Index of the last cycle start in the window. */
+    uint16_t lastLength;    /**< Length of the last cycle in sampling waves. */
+    bool     bPositive;     /**< true if the band-passed signal is in its positive half. */
+    bool     bPrimed;       /**< true once the filters are initialized. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Initializes a breathing rate estimator.
+  *
+  *  @param [out] sBreath
+  *      Reference to the estimator.
+  *  @param [in] delta
+  *      Time between two sampling waves in ms.
+  */
+ void breath_init(struct sBreathEstimator* sBreath, const uint16_t delta);
+
+ /**
+  *	Feeds a wave of FSC's sampling to the estimator.
+  *
+  *  @param [in,out] sBreath
+  *      Reference to the estimator.
+  *  @param [in] fscValues
+  *      Wave of FSC's sampling.
+  *
+  *  @return true if an analysis window is complete, false otherwise.
+  *
+  *  @see breath_getSummary()
+  */
+ bool breath_update(struct sBreathEstimator* sBreath, uint16_t const fscValues[PROTOCOL_FSC_NUMBER]);
+
+ /**
+  *	Computes the summary of the analysis window and starts a new one.
+  *
+  *  @param [in,out] sBreath
+  *      Reference to the estimator.
+  *  @param [out] sBre
+  *      Reference to the container where store the summary.
+  *      The time field isn't modified.
+  *
+  *  @see breath_update()
+  *  @see protocol_createBRE()
+  */
+ void breath_getSummary(struct sBreathEstimator* sBreath, struct sProtocolBRE* sBre);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
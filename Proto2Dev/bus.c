@@ -0,0 +1,79 @@
+/**
+ *  @copybrief bus.h
+ *  @copydetails bus.h
+ *
+ *  @file bus.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "bus.h"
+
+/**
+ *	Time of the reserved sweep.
+ *
+ *  @internal
+ */
+static uint32_t bus_deadline = 0;
+
+/**
+ *	End of the last transfer with the memory.
+ *
+ *  @internal
+ */
+static uint32_t bus_lastEnd = 0;
+
+/**
+ *	Longest delay caused to a sweep since the last report in ms.
+ *
+ *  @internal
+ */
+static uint16_t bus_worstDelay = 0;
+
+void bus_reserve(const uint32_t deadline)
+{
+    bus_deadline = deadline;
+}
+
+bool bus_mayTransfer(const uint32_t time, const uint32_t now)
+{
+    int32_t left;
+
+    left = (int32_t)(bus_deadline - now);
+    if (left <= 0)
+        return true;
+
+    return ((uint32_t)left * 1000 >= time);
+}
+
+void bus_end(const uint32_t now)
+{
+    bus_lastEnd = now;
+}
+
+void bus_sweep(const uint32_t deadline, const uint32_t now)
+{
+    uint32_t delay;
+
+    /* Only a transfer ending after the deadline delays the sweep. */
+    if ((int32_t)(bus_lastEnd - deadline) <= 0 || (int32_t)(now - deadline) <= 0)
+        return;
+    delay = now - deadline;
+    if (delay > UINT16_MAX)
+        delay = UINT16_MAX;
+    if (delay > bus_worstDelay)
+        bus_worstDelay = (uint16_t)delay;
+}
+
+uint16_t bus_getWorstDelay(void)
+{
+    uint16_t delay;
+
+    delay = bus_worstDelay;
+    bus_worstDelay = 0;
+
+    return delay;
+}
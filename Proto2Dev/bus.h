@@ -0,0 +1,119 @@
+/**
+ *  Arbiter of the I2C bus shared by the ADC and the 24XX1026 memory.
+ *
+ *  The ADC's sweeps come first : while sleeping until the next deadline of
+ *  the scheduler, the bus is reserved for it with bus_reserve(). Work moving
+ *  data through the memory, a step of a burst for instance, is started only
+ *  if bus_mayTransfer() finds enough time before the reservation, otherwise
+ *  it waits for the next sleep. Its time is counted by bus_getTime() : the
+ *  bytes on the wire, the addressing of each transfer, and the write cycle
+ *  of each page written, the driver polling the memory until its end.
+ *
+ *  Work started out of a sleep, a spill of the queue for instance, isn't
+ *  checked : the end of each transfer with the memory is marked by bus_end()
+ *  and the start of each sweep by bus_sweep(), so a sweep started late while
+ *  the memory held the bus past its deadline is measured. The worst delay is
+ *  reported by the STA frame.
+ *
+ *  @file bus.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef BUS_H
+ #define BUS_H
+
+ #include <inttypes.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ /**
+  *	Time of a byte on the bus in us, with its acknowledgment at 100 kHz.
+  */
+ #define BUS_BYTE_TIME              90
+ /**
+  *	Time of the addressing of a transfer in us.
+  */
+ #define BUS_ADDRESS_TIME           300
+ /**
+  *	Time of the write cycle of a page of the memory in us.
+  */
+ #define BUS_WRITE_CYCLE_TIME       5000
+
+ /**
+  *	Computes the time the memory holds the bus in us.
+  *
+  *  @param [in] bytes
+  *      Number of bytes on the wire.
+  *  @param [in] transfers
+  *      Number of transfers, each one addressed.
+  *  @param [in] pages
+  *      Number of pages written.
+  */
+ #define bus_getTime(bytes, transfers, pages)   ((uint32_t)(bytes) * BUS_BYTE_TIME + (uint32_t)(transfers) * BUS_ADDRESS_TIME + (uint32_t)(pages) * BUS_WRITE_CYCLE_TIME)
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Reserves the bus for a sweep of the ADC.
+  *
+  *  @param [in] deadline
+  *      Time of the sweep in ms, a past one being no reservation.
+  */
+ void bus_reserve(const uint32_t deadline);
+
+ /**
+  *	Determines if a transfer may go through the bus before the reservation.
+  *
+  *  @param [in] time
+  *      Time of the transfer at most in us.
+  *  @param [in] now
+  *      Current time in ms.
+  *
+  *  @return true if it would leave the bus before the reservation, false otherwise.
+  *
+  *  @see bus_getTime()
+  */
+ bool bus_mayTransfer(const uint32_t time, const uint32_t now);
+
+ /**
+  *	Marks the end of a transfer with the memory.
+  *
+  *  @param [in] now
+  *      Current time in ms.
+  */
+ void bus_end(const uint32_t now);
+
+ /**
+  *	Marks the start of a sweep of the ADC.
+  *
+  *  Its delay is recorded if the memory held the bus past its deadline.
+  *
+  *  @param [in] deadline
+  *      Time the sweep was due in ms.
+  *  @param [in] now
+  *      Current time in ms.
+  *
+  *  @see scheduler_getDeadline()
+  */
+ void bus_sweep(const uint32_t deadline, const uint32_t now);
+
+ /**
+  *	Retrieves the longest delay caused to a sweep since the last call.
+  *
+  *  @return The delay in ms, saturated.
+  */
+ uint16_t bus_getWorstDelay(void);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,103 @@
+/**
+ *  @copybrief calibration.h
+ *  @copydetails calibration.h
+ *
+ *  @file calibration.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "calibration.h"
+
+/**
+ *	Computes the CRC of a table.
+ *
+ *  @internal
+ *
+ *  @param [in] sTable
+ *      Reference to the table.
+ *
+ *  @return The CRC of every fields but crc.
+ */
+static uint16_t calibration_crc(struct sCalibrationTable const* sTable);
+
+static uint16_t calibration_crc(struct sCalibrationTable const* sTable)
+{
+    uint16_t crc;
+
+    crc = crc_update(CRC_INIT, &(sTable->magic), sizeof(sTable->magic));
+
+    return crc_update(crc, sTable->points, sizeof(sTable->points));
+}
+
+void calibration_setIdentity(struct sCalibrationTable* sTable)
+{
+    uint8_t iterChannel;
+    uint8_t iterPoint;
+
+    assert(sTable != NULL);
+
+    sTable->magic = CALIBRATION_MAGIC;
+    for (iterChannel = 0 ; iterChannel < CALIBRATION_CHANNEL_NUMBER ; iterChannel++)
+        for (iterPoint = 0 ; iterPoint < PROTOCOL_CAL_POINT_NUMBER ; iterPoint++)
+            sTable->points[iterChannel][iterPoint] = (uint16_t)iterPoint << CALIBRATION_SEGMENT_BITS;
+    sTable->crc = calibration_crc(sTable);
+}
+
+bool calibration_isValid(struct sCalibrationTable const* sTable)
+{
+    assert(sTable != NULL);
+
+    return (sTable->magic == CALIBRATION_MAGIC && sTable->crc == calibration_crc(sTable));
+}
+
+void calibration_set(struct sCalibrationTable* sTable, struct sProtocolCAL const* sCal)
+{
+    assert(sTable != NULL);
+    assert(sCal != NULL);
+    assert(sCal->channel < CALIBRATION_CHANNEL_NUMBER);
+
+    memcpy(sTable->points[sCal->channel], sCal->points, sizeof(sTable->points[0]));
+    sTable->crc = calibration_crc(sTable);
+}
+
+uint16_t calibration_apply(struct sCalibrationTable const* sTable, const uint8_t channel, const uint16_t raw)
+{
+    uint16_t const* points;
+    uint8_t segment;
+    int32_t slope;
+
+    assert(sTable != NULL);
+    assert(channel < CALIBRATION_CHANNEL_NUMBER);
+
+    points = sTable->points[channel];
+    segment = raw >> CALIBRATION_SEGMENT_BITS;
+    if (segment >= PROTOCOL_CAL_POINT_NUMBER - 1)
+        segment = PROTOCOL_CAL_POINT_NUMBER - 2;
+    slope = (int32_t)points[segment + 1] - points[segment];
+
+    return points[segment] + ((slope * (raw - ((uint16_t)segment << CALIBRATION_SEGMENT_BITS))) >> CALIBRATION_SEGMENT_BITS);
+}
+
+void calibration_applyFSR(struct sCalibrationTable const* sTable, uint16_t fsrValues[PROTOCOL_FSR_NUMBER])
+{
+    uint8_t iterFsr;
+
+    assert(fsrValues != NULL);
+
+    for (iterFsr = 0 ; iterFsr < PROTOCOL_FSR_NUMBER ; iterFsr++)
+        fsrValues[iterFsr] = calibration_apply(sTable, iterFsr, fsrValues[iterFsr]);
+}
+
+void calibration_applyFSC(struct sCalibrationTable const* sTable, uint16_t fscValues[PROTOCOL_FSC_NUMBER])
+{
+    uint8_t iterFsc;
+
+    assert(fscValues != NULL);
+
+    for (iterFsc = 0 ; iterFsc < PROTOCOL_FSC_NUMBER ; iterFsc++)
+        fscValues[iterFsc] = calibration_apply(sTable, PROTOCOL_FSR_NUMBER + iterFsc, fscValues[iterFsc]);
+}
@@ -0,0 +1,138 @@
+/**
+ *  Bed sensor's calibration of FSR's and FSC's channels.
+ *
+ *  Each channel has a piecewise linear curve of PROTOCOL_CAL_POINT_NUMBER
+ *  points equally spaced over the raw values, so finding the segment of a
+ *  raw value is a shift and the interpolation is done in fixed point.
+ *
+ *  Tables are stored in the 24XX1026 memory at CALIBRATION_EEPROM_ADDR
+ *  and checked with a CRC before use.
+ *
+ *  @file calibration.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef CALIBRATION_H
+ #define CALIBRATION_H
+
+ #include <inttypes.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+ #include "crc.h"
+
+ /**
+  *	Number of calibrated channels (FSR's channels first, then FSC's channels).
+  */
+ #define CALIBRATION_CHANNEL_NUMBER ((PROTOCOL_FSR_NUMBER) + (PROTOCOL_FSC_NUMBER))
+ /**
+  *	Number of bits of a raw value.
+  */
+ #define CALIBRATION_RAW_BITS       12
+ /**
+  *	Number of bits of the raw values covered by a segment of a curve.
+  *
+  *  @warning PROTOCOL_CAL_POINT_NUMBER - 1 must be a power of two.
+  */
+ #define CALIBRATION_SEGMENT_BITS   10
+ /**
+  *	Identifier of the current format of calibration tables.
+  */
+ #define CALIBRATION_MAGIC          0xCA01
+ /**
+  *	Address of the calibration table in the 24XX1026 memory.
+  *
+  *  @note The table fits in the first page.
+  */
+ #define CALIBRATION_EEPROM_ADDR    0x00000
+
+ /**
+  *	Calibration curves of every channels.
+  */
+ struct sCalibrationTable
+ {
+    uint16_t magic;                                                         /**< CALIBRATION_MAGIC for a valid table. */
+    uint16_t points[CALIBRATION_CHANNEL_NUMBER][PROTOCOL_CAL_POINT_NUMBER]; /**< Calibrated values at equally spaced raw values. */
+    uint16_t crc;                                                           /**< CRC of the previous fields. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Fills a table with identity curves.
+  *
+  *  @param [out] sTable
+  *      Reference to the table.
+  */
+ void calibration_setIdentity(struct sCalibrationTable* sTable);
+
+ /**
+  *	Checks a table read from memory.
+  *
+  *  @param [in] sTable
+  *      Reference to the table.
+  *
+  *  @return true if the table is usable, false otherwise.
+  */
+ bool calibration_isValid(struct sCalibrationTable const* sTable);
+
+ /**
+  *	Installs the curve of a channel received from the platform.
+  *
+  *  @param [in,out] sTable
+  *      Reference to the table.
+  *  @param [in] sCal
+  *      Curve of the channel.
+  *
+  *  @see protocol_parseCAL()
+  */
+ void calibration_set(struct sCalibrationTable* sTable, struct sProtocolCAL const* sCal);
+
+ /**
+  *	Calibrates a raw value of a channel.
+  *
+  *  @param [in] sTable
+  *      Reference to the table.
+  *  @param [in] channel
+  *      Channel of the value [0;CALIBRATION_CHANNEL_NUMBER[.
+  *  @param [in] raw
+  *      Raw value [0;2^CALIBRATION_RAW_BITS[.
+  *
+  *  @return The calibrated value.
+  */
+ uint16_t calibration_apply(struct sCalibrationTable const* sTable, const uint8_t channel, const uint16_t raw);
+
+ /**
+  *	Calibrates a sweep of FSR's in place.
+  *
+  *  @param [in] sTable
+  *      Reference to the table.
+  *  @param [in,out] fsrValues
+  *      Sweep of FSR's.
+  */
+ void calibration_applyFSR(struct sCalibrationTable const* sTable, uint16_t fsrValues[PROTOCOL_FSR_NUMBER]);
+
+ /**
+  *	Calibrates a wave of FSC's in place.
+  *
+  *  @param [in] sTable
+  *      Reference to the table.
+  *  @param [in,out] fscValues
+  *      Wave of FSC's.
+  */
+ void calibration_applyFSC(struct sCalibrationTable const* sTable, uint16_t fscValues[PROTOCOL_FSC_NUMBER]);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
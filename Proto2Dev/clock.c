@@ -0,0 +1,125 @@
+/**
+ *  @copybrief clock.h
+ *  @copydetails clock.h
+ *
+ *  @file clock.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "clock.h"
+
+void clock_init(struct sClock* sClock, const uint32_t now)
+{
+    assert(sClock != NULL);
+
+    memset(sClock, 0, sizeof(*sClock));
+    sClock->nextSync = now;
+}
+
+bool clock_isDue(struct sClock const* sClock, const uint32_t now)
+{
+    assert(sClock != NULL);
+
+    return ((int32_t)(now - sClock->nextSync) >= 0);
+}
+
+uint16_t clock_request(struct sClock* sClock, const uint32_t now, tProtocol_bufferSYN buffer)
+{
+    assert(sClock != NULL);
+    assert(buffer != NULL);
+
+    sClock->requestTime = now;
+    sClock->bPending = true;
+    /* Again later if the platform doesn't answer. */
+    sClock->nextSync = now + CLOCK_RETRY_DELAY;
+
+    return protocol_createSYN(now, buffer);
+}
+
+void clock_stamp(struct sClock* sClock, const uint32_t now)
+{
+    assert(sClock != NULL);
+
+    if (!sClock->bPending)
+        return;
+    sClock->requestTime = now;
+    sClock->nextSync = now + CLOCK_RETRY_DELAY;
+}
+
+bool clock_receive(struct sClock* sClock, const uint32_t platformTime, const uint32_t now)
+{
+    uint32_t rtt;
+    uint32_t measured;
+    uint32_t span;
+    int32_t error;
+    int32_t correction;
+
+    assert(sClock != NULL);
+
+    if (!sClock->bPending)
+    {
+        /* A request of the platform. */
+        sClock->nextSync = now;
+        return false;
+    }
+    sClock->bPending = false;
+    rtt = now - sClock->requestTime;
+    if (rtt > CLOCK_RTT_MAX)
+    {
+        sClock->nextSync = now + CLOCK_RETRY_DELAY;
+        return false;
+    }
+    /* The answer left the platform half a round trip ago. */
+    measured = platformTime + rtt / 2;
+    if (sClock->nbSync > 0)
+    {
+        span = now - sClock->syncLocal;
+        if (span >= CLOCK_SPAN_MIN)
+        {
+            /* The error left since the last synchronization is due to the drift. */
+            error = (int32_t)(measured - clock_toPlatform(sClock, now));
+            correction = (int32_t)(((int64_t)error << CLOCK_DRIFT_SHIFT) / (int64_t)span);
+            /* The first measure is taken as is, the next ones are filtered. */
+            if (sClock->nbSync > 1)
+                correction /= (1 << CLOCK_DRIFT_GAIN);
+            sClock->drift += correction;
+            if (sClock->drift > CLOCK_DRIFT_MAX)
+                sClock->drift = CLOCK_DRIFT_MAX;
+            else if (sClock->drift < -CLOCK_DRIFT_MAX)
+                sClock->drift = -CLOCK_DRIFT_MAX;
+        }
+    }
+    sClock->syncLocal = now;
+    sClock->syncPlatform = measured;
+    sClock->rtt = (uint16_t)rtt;
+    if (sClock->nbSync < UINT8_MAX)
+        sClock->nbSync++;
+    sClock->nextSync = now + CLOCK_SYNC_PERIOD;
+
+    return true;
+}
+
+uint32_t clock_toPlatform(struct sClock const* sClock, const uint32_t local)
+{
+    int32_t elapsed;
+
+    assert(sClock != NULL);
+
+    if (sClock->nbSync == 0)
+        return local;
+    /* Signed : a sample may be older than the last synchronization. */
+    elapsed = (int32_t)(local - sClock->syncLocal);
+
+    return sClock->syncPlatform + (uint32_t)elapsed + (uint32_t)(int32_t)(((int64_t)elapsed * sClock->drift) >> CLOCK_DRIFT_SHIFT);
+}
+
+bool clock_isSynchronized(struct sClock const* sClock)
+{
+    assert(sClock != NULL);
+
+    return (sClock->nbSync > 0);
+}
@@ -0,0 +1,181 @@
+/**
+ *  Synchronization of the bed sensor's clock on the platform's one.
+ *
+ *  The bed sensor sends its time in a SYN frame, the platform answers at once
+ *  with its own time in a SYN frame. Half the round trip gives the platform's
+ *  time at the reception of the answer, so the offset between both clocks.
+ *  Exchanges are repeated every CLOCK_SYNC_PERIOD, the error left between
+ *  two of them gives the drift of the resonator, filtered and kept in fixed
+ *  point. Timestamps are then converted to the platform's clock, so the
+ *  platform aligns several beds without regression over whole nights, and
+ *  millis() may wrap as long as exchanges go on.
+ *
+ *  A SYN frame received while no answer is awaited is a request of the
+ *  platform : the bed sensor starts an exchange at once.
+ *
+ *  @file clock.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef CLOCK_H
+ #define CLOCK_H
+
+ #include <inttypes.h>
+ #include <string.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+
+ /**
+  *	Period of the exchanges in ms.
+  */
+ #ifndef CLOCK_SYNC_PERIOD
+  #define CLOCK_SYNC_PERIOD         600000
+ #endif
+ /**
+  *	Delay before a new exchange after an unanswered or slow one in ms.
+  */
+ #define CLOCK_RETRY_DELAY          30000
+ /**
+  *	Longest round trip of an exchange in ms.
+  *
+  *  @note The error on the offset is at most half the round trip.
+  */
+ #define CLOCK_RTT_MAX              100
+ /**
+  *	Shortest time between two exchanges giving the drift in ms.
+  */
+ #define CLOCK_SPAN_MIN             60000
+ /**
+  *	Fractional bits of the drift.
+  */
+ #define CLOCK_DRIFT_SHIFT          24
+ /**
+  *	Greatest drift accepted, 1 % in 2^-CLOCK_DRIFT_SHIFT.
+  */
+ #define CLOCK_DRIFT_MAX            ((int32_t)(((int64_t)1 << (CLOCK_DRIFT_SHIFT)) / 100))
+ /**
+  *	Weight of a new measure of the drift, 2^-CLOCK_DRIFT_GAIN.
+  */
+ #define CLOCK_DRIFT_GAIN           2
+
+ /**
+  *	State of the synchronization.
+  */
+ struct sClock
+ {
+    uint32_t syncLocal;     /**< Local time of the last synchronization in ms. */
+    uint32_t syncPlatform;  /**< Platform's time at syncLocal in ms. */
+    int32_t  drift;         /**< Platform's ms gained per local ms, in 2^-CLOCK_DRIFT_SHIFT. */
+    uint32_t requestTime;   /**< Local time of the awaited exchange in ms. */
+    uint32_t nextSync;      /**< Local time of the next exchange in ms. */
+    uint16_t rtt;           /**< Round trip of the last exchange in ms. */
+    uint8_t  nbSync;        /**< Number of synchronizations, saturated. */
+    bool     bPending;      /**< An answer of the platform is awaited. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Forgets any synchronization, an exchange is due at once.
+  *
+  *  @param [out] sClock
+  *      Reference to the state.
+  *  @param [in] now
+  *      Local time in ms.
+  */
+ void clock_init(struct sClock* sClock, const uint32_t now);
+
+ /**
+  *	Determines if an exchange is due.
+  *
+  *  @param [in] sClock
+  *      Reference to the state.
+  *  @param [in] now
+  *      Local time in ms.
+  *
+  *  @return true if clock_request() should be called, false otherwise.
+  */
+ bool clock_isDue(struct sClock const* sClock, const uint32_t now);
+
+ /**
+  *	Starts an exchange.
+  *
+  *  @param [in,out] sClock
+  *      Reference to the state.
+  *  @param [in] now
+  *      Local time in ms.
+  *  @param [out] buffer
+  *      Reference where store the SYN frame to send.
+  *
+  *  @return The length of the frame.
+  *
+  *  @see clock_stamp()
+  */
+ uint16_t clock_request(struct sClock* sClock, const uint32_t now, tProtocol_bufferSYN buffer);
+
+ /**
+  *	Stamps the exchange when its frame is handed to the radio.
+  *
+  *  The round trip is measured from this time, not from the request :
+  *  the frame may wait in the transmit queue meanwhile.
+  *
+  *  @param [in,out] sClock
+  *      Reference to the state.
+  *  @param [in] now
+  *      Local time in ms.
+  */
+ void clock_stamp(struct sClock* sClock, const uint32_t now);
+
+ /**
+  *	Handles a SYN frame of the platform.
+  *
+  *  @param [in,out] sClock
+  *      Reference to the state.
+  *  @param [in] platformTime
+  *      Time given by the frame in ms.
+  *  @param [in] now
+  *      Local time of its reception in ms.
+  *
+  *  @return true if the clock is synchronized again, false otherwise.
+  *
+  *  @see protocol_parseSYN()
+  */
+ bool clock_receive(struct sClock* sClock, const uint32_t platformTime, const uint32_t now);
+
+ /**
+  *	Converts a local time into the platform's clock.
+  *
+  *  @param [in] sClock
+  *      Reference to the state.
+  *  @param [in] local
+  *      Local time in ms, from millis().
+  *
+  *  @return The platform's time in ms, local itself until a first synchronization.
+  */
+ uint32_t clock_toPlatform(struct sClock const* sClock, const uint32_t local);
+
+ /**
+  *	Determines if the clock has been synchronized at least once.
+  *
+  *  @param [in] sClock
+  *      Reference to the state.
+  *
+  *  @return true if timestamps are on the platform's clock, false otherwise.
+  */
+ bool clock_isSynchronized(struct sClock const* sClock);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,170 @@
+/**
+ *  @copybrief config.h
+ *  @copydetails config.h
+ *
+ *  @file config.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "config.h"
+
+/**
+ *	Computes the CRC of a block.
+ *
+ *  @internal
+ *
+ *  @param [in] sConfig
+ *      Reference to the block.
+ *
+ *  @return The CRC of every fields but crc.
+ */
+static uint16_t config_crc(struct sConfig const* sConfig);
+
+static uint16_t config_crc(struct sConfig const* sConfig)
+{
+    return crc_update(CRC_INIT, sConfig, offsetof(struct sConfig, crc));
+}
+
+void config_setDefaults(struct sConfig* sConfig)
+{
+    assert(sConfig != NULL);
+
+    memset(sConfig, 0, sizeof(*sConfig));
+    sConfig->magic       = CONFIG_MAGIC;
+    sConfig->version     = CONFIG_VERSION;
+    sConfig->sleepTime   = CONFIG_SLEEP_TIME;
+    sConfig->sleepPeriod = CONFIG_SLEEP_PERIOD;
+    sConfig->sleepDelta  = CONFIG_SLEEP_DELTA;
+    sConfig->monitorTime = CONFIG_MONITOR_TIME;
+    sConfig->fsrPeriod   = CONFIG_FSR_PERIOD;
+    sConfig->fscPeriod   = CONFIG_FSC_PERIOD;
+    sConfig->hfcPeriod   = CONFIG_HFC_PERIOD;
+    sConfig->fsrMask     = CONFIG_FSR_MASK;
+    sConfig->fscMask     = CONFIG_FSC_MASK;
+    sConfig->options     = CONFIG_OPTIONS;
+    sConfig->crc = config_crc(sConfig);
+}
+
+bool config_isValid(struct sConfig const* sConfig)
+{
+    assert(sConfig != NULL);
+
+    return (sConfig->magic == CONFIG_MAGIC && sConfig->version == CONFIG_VERSION && sConfig->crc == config_crc(sConfig));
+}
+
+bool config_set(struct sConfig* sConfig, const eProtocolConfig key, const uint32_t value)
+{
+    assert(sConfig != NULL);
+
+    switch (key)
+    {
+        case cProtocolConfigDefaults :
+            config_setDefaults(sConfig);
+            return true;
+        case cProtocolConfigSleepTime :
+            if (value == 0)
+                return false;
+            sConfig->sleepTime = value;
+            break;
+        case cProtocolConfigSleepPeriod :
+            if (value == 0)
+                return false;
+            sConfig->sleepPeriod = value;
+            break;
+        case cProtocolConfigSleepDelta :
+            if (value == 0 || value >= 4096)
+                return false;
+            sConfig->sleepDelta = value;
+            break;
+        case cProtocolConfigMonitorTime :
+            if (value == 0)
+                return false;
+            sConfig->monitorTime = value;
+            break;
+        case cProtocolConfigFsrPeriod :
+            /* The FSC's waves are sampled between the FSR's sweeps. */
+            if (value <= sConfig->fscPeriod)
+                return false;
+            if ((sConfig->options & CONFIG_OPTION_SYNC) && value % sConfig->fscPeriod != 0)
+                return false;
+            sConfig->fsrPeriod = value;
+            break;
+        case cProtocolConfigFscPeriod :
+            /* Sent as the 16 bits delta of the DCN frames. */
+            if (value == 0 || value >= sConfig->fsrPeriod || value > UINT16_MAX)
+                return false;
+            if ((sConfig->options & CONFIG_OPTION_SYNC) && sConfig->fsrPeriod % value != 0)
+                return false;
+            sConfig->fscPeriod = value;
+            break;
+        case cProtocolConfigFsrMask :
+            if (value & ~(uint32_t)CONFIG_FSR_MASK)
+                return false;
+            sConfig->fsrMask = value;
+            break;
+        case cProtocolConfigFscMask :
+            if (value & ~(uint32_t)CONFIG_FSC_MASK)
+                return false;
+            sConfig->fscMask = value;
+            break;
+        case cProtocolConfigOptions :
+            if (value & ~(uint32_t)CONFIG_OPTION_ALL)
+                return false;
+            /* The FSR's sweeps fall on the FSC's ticks. */
+            if ((value & CONFIG_OPTION_SYNC) && sConfig->fsrPeriod % sConfig->fscPeriod != 0)
+                return false;
+            sConfig->options = value;
+            break;
+        case cProtocolConfigHfcPeriod :
+            /* Sent as the 16 bits delta of the DCH frames. */
+            if ((value != 0 && value < CONFIG_HFC_PERIOD_MIN) || value > UINT16_MAX)
+                return false;
+            sConfig->hfcPeriod = value;
+            break;
+        default :
+            return false;
+    }
+    sConfig->crc = config_crc(sConfig);
+
+    return true;
+}
+
+uint32_t config_get(struct sConfig const* sConfig, const eProtocolConfig key)
+{
+    assert(sConfig != NULL);
+
+    switch (key)
+    {
+        case cProtocolConfigSleepTime :     return sConfig->sleepTime;
+        case cProtocolConfigSleepPeriod :   return sConfig->sleepPeriod;
+        case cProtocolConfigSleepDelta :    return sConfig->sleepDelta;
+        case cProtocolConfigMonitorTime :   return sConfig->monitorTime;
+        case cProtocolConfigFsrPeriod :     return sConfig->fsrPeriod;
+        case cProtocolConfigFscPeriod :     return sConfig->fscPeriod;
+        case cProtocolConfigFsrMask :       return sConfig->fsrMask;
+        case cProtocolConfigFscMask :       return sConfig->fscMask;
+        case cProtocolConfigOptions :       return sConfig->options;
+        case cProtocolConfigHfcPeriod :     return sConfig->hfcPeriod;
+        default :                           return 0;
+    }
+}
+
+void config_setIdentity(struct sConfig* sConfig, const uint32_t id1, const uint32_t id2)
+{
+    assert(sConfig != NULL);
+
+    sConfig->id1 = id1;
+    sConfig->id2 = id2;
+    sConfig->crc = config_crc(sConfig);
+}
+
+bool config_hasIdentity(struct sConfig const* sConfig)
+{
+    assert(sConfig != NULL);
+
+    return (sConfig->id1 != 0 || sConfig->id2 != 0);
+}
@@ -0,0 +1,181 @@
+/**
+ *  Bed sensor's runtime configuration.
+ *
+ *  Timing, thresholds, channels and encoding set by the platform with CFG
+ *  frames, so tuning doesn't need a new firmware. The configuration is a
+ *  single block stored in the 24XX1026 memory at CONFIG_EEPROM_ADDR, read
+ *  once at boot and checked with its version and a CRC before use. It also
+ *  caches the radio's identity, so it's queried only at the first boot.
+ *
+ *  @file config.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef CONFIG_H
+ #define CONFIG_H
+
+ #include <inttypes.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+ #include "crc.h"
+
+ /**
+  *	Identifier of configuration blocks.
+  */
+ #define CONFIG_MAGIC               0xC0F6
+ /**
+  *	Version of the layout of sConfig, blocks of another version are ignored.
+  */
+ #define CONFIG_VERSION             2
+ /**
+  *	Address of the configuration block in the 24XX1026 memory.
+  *
+  *  @note The block fits in the second page, after the calibration table.
+  */
+ #define CONFIG_EEPROM_ADDR         0x00080
+ /**
+  *	Default values of the parameters.
+  */
+ #define CONFIG_SLEEP_TIME          10000
+ #define CONFIG_SLEEP_PERIOD        1000
+ #define CONFIG_SLEEP_DELTA         512
+ #define CONFIG_MONITOR_TIME        60000
+ #define CONFIG_FSR_PERIOD          1000
+ #define CONFIG_FSC_PERIOD          100
+ #define CONFIG_HFC_PERIOD          4000
+ #define CONFIG_FSR_MASK            ((1U << (PROTOCOL_FSR_NUMBER)) - 1)
+ #define CONFIG_FSC_MASK            ((1U << (PROTOCOL_FSC_NUMBER)) - 1)
+ #define CONFIG_OPTIONS             0
+ /**
+  *	Shortest period of the FSC's waves of the accurate monitorings in us :
+  *  the conversions of a wave hold the I2C bus for about 1 ms.
+  */
+ #define CONFIG_HFC_PERIOD_MIN      2000
+ /**
+  *	Encoding option : monitorings stream raw DR1/DCN frames instead of summaries.
+  */
+ #define CONFIG_OPTION_RAW          0x01
+ /**
+  *	Encoding option : raw monitorings sample the FSR and the FSC on the same
+  *  tick and stream DAN frames, the FSR's period being a multiple of the FSC's one.
+  */
+ #define CONFIG_OPTION_SYNC         0x02
+ /**
+  *	Encoding option : raw monitorings adapt their periods to the activity,
+  *  from half the configured ones during movements to twice during a stable breathing.
+  */
+ #define CONFIG_OPTION_ADAPTIVE     0x04
+ /**
+  *	Every encoding options known.
+  */
+ #define CONFIG_OPTION_ALL          (CONFIG_OPTION_RAW | CONFIG_OPTION_SYNC | CONFIG_OPTION_ADAPTIVE)
+
+ /**
+  *	Configuration block.
+  */
+ struct sConfig
+ {
+    uint16_t magic;         /**< CONFIG_MAGIC for a valid block. */
+    uint8_t  version;       /**< CONFIG_VERSION for a valid block. */
+    uint32_t sleepTime;     /**< Duration of a watch for a person in ms. */
+    uint32_t sleepPeriod;   /**< Period of the FSR's sweeps while watching in ms. */
+    uint32_t monitorTime;   /**< Maximum duration of a monitoring in ms. */
+    uint32_t fsrPeriod;     /**< Period of the FSR's sweeps while monitoring in ms. */
+    uint32_t fscPeriod;     /**< Period of the FSC's waves while monitoring in ms. */
+    uint16_t hfcPeriod;     /**< Period of the FSC's waves of the accurate monitorings in us, 0 for fscPeriod. */
+    uint16_t sleepDelta;    /**< Change of an FSR revealing an activity. */
+    uint8_t  fsrMask;       /**< FSR's channels in use, bit i for channel i. */
+    uint8_t  fscMask;       /**< FSC's channels in use, bit i for channel i. */
+    uint8_t  options;       /**< Encoding options (CONFIG_OPTION_XXX). */
+    uint32_t id1;           /**< Radio's serial number high (SH) in network order, 0 if unknown. */
+    uint32_t id2;           /**< Radio's serial number low (SL) in network order. */
+    uint16_t crc;           /**< CRC of the previous fields. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Fills a block with the default values, without identity.
+  *
+  *  @param [out] sConfig
+  *      Reference to the block.
+  */
+ void config_setDefaults(struct sConfig* sConfig);
+
+ /**
+  *	Checks a block read from memory.
+  *
+  *  @param [in] sConfig
+  *      Reference to the block.
+  *
+  *  @return true if the block is usable, false otherwise.
+  */
+ bool config_isValid(struct sConfig const* sConfig);
+
+ /**
+  *	Changes a parameter received from the platform.
+  *
+  *  @param [in,out] sConfig
+  *      Reference to the block.
+  *  @param [in] key
+  *      The parameter.
+  *  @param [in] value
+  *      Value of the parameter.
+  *
+  *  @return true if the value is applied, false if it's out of range.
+  *
+  *  @see protocol_parseCFG()
+  */
+ bool config_set(struct sConfig* sConfig, const eProtocolConfig key, const uint32_t value);
+
+ /**
+  *	Gives the value of a parameter.
+  *
+  *  @param [in] sConfig
+  *      Reference to the block.
+  *  @param [in] key
+  *      The parameter.
+  *
+  *  @return The value, 0 for cProtocolConfigDefaults.
+  *
+  *  @see protocol_createCFG()
+  */
+ uint32_t config_get(struct sConfig const* sConfig, const eProtocolConfig key);
+
+ /**
+  *	Caches the radio's identity.
+  *
+  *  @param [in,out] sConfig
+  *      Reference to the block.
+  *  @param [in] id1
+  *      Radio's serial number high (SH) in network order.
+  *  @param [in] id2
+  *      Radio's serial number low (SL) in network order.
+  */
+ void config_setIdentity(struct sConfig* sConfig, const uint32_t id1, const uint32_t id2);
+
+ /**
+  *	Determines if the radio's identity is cached.
+  *
+  *  @param [in] sConfig
+  *      Reference to the block.
+  *
+  *  @return true if id1 and id2 are known, false otherwise.
+  */
+ bool config_hasIdentity(struct sConfig const* sConfig);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
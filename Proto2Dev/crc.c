@@ -0,0 +1,30 @@
+/**
+ *  @copybrief crc.h
+ *  @copydetails crc.h
+ *
+ *  @file crc.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "crc.h"
+
+uint16_t crc_update(uint16_t crc, const void* data, const size_t n)
+{
+    uint8_t const* cur;
+    size_t i;
+    uint8_t iterBit;
+
+    cur = (uint8_t const*) data;
+    for (i = 0 ; i < n ; i++)
+    {
+        crc ^= ((uint16_t)cur[i]) << 8;
+        for (iterBit = 0 ; iterBit < 8 ; iterBit++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+
+    return crc;
+}
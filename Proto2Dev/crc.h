@@ -0,0 +1,47 @@
+/**
+ *  Cyclic redundancy check.
+ *
+ *  CRC-16-CCITT (polynomial 0x1021) used to check data blocks
+ *  stored by the bed sensor.
+ *
+ *  @file crc.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef CRC_H
+ #define CRC_H
+
+ #include <inttypes.h>
+ #include <stddef.h>
+
+ /**
+  *	Initial value of a CRC computation.
+  */
+ #define CRC_INIT                   0xFFFF
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Updates a CRC with a memory area.
+  *
+  *  @param [in] crc
+  *      Current CRC, CRC_INIT for the first area.
+  *  @param [in] data
+  *      Reference to the memory area.
+  *  @param [in] n
+  *      Size of the memory area in bytes.
+  *
+  *  @return The updated CRC.
+  */
+ uint16_t crc_update(uint16_t crc, const void* data, const size_t n);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,122 @@
+/**
+ *  @copybrief epoch.h
+ *  @copydetails epoch.h
+ *
+ *  @file epoch.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "epoch.h"
+
+void epoch_init(struct sEpochAggregator* sEpoch)
+{
+    assert(sEpoch != NULL);
+
+    sEpoch->nbSweeps = 0;
+}
+
+bool epoch_update(struct sEpochAggregator* sEpoch, uint16_t const fsrValues[PROTOCOL_FSR_NUMBER], const uint32_t time)
+{
+    struct sPressure sPress;
+    uint32_t diff;
+    bool bOccupied;
+    uint8_t iterFsr;
+
+    assert(sEpoch != NULL);
+    assert(fsrValues != NULL);
+
+    if (sEpoch->nbSweeps == 0)
+    {
+        /* First sweep of the epoch. */
+        sEpoch->start         = time;
+        sEpoch->copSum        = 0;
+        sEpoch->copMin        = INT16_MAX;
+        sEpoch->copMax        = INT16_MIN;
+        sEpoch->nbOccupied    = 0;
+        for (iterFsr = 0 ; iterFsr < PROTOCOL_FSR_NUMBER ; iterFsr++)
+        {
+            sEpoch->sum[iterFsr]       = 0;
+            sEpoch->sumSqDiff[iterFsr] = 0;
+            sEpoch->min[iterFsr]       = UINT16_MAX;
+            sEpoch->max[iterFsr]       = 0;
+            sEpoch->last[iterFsr]      = fsrValues[iterFsr];
+        }
+    }
+
+    for (iterFsr = 0 ; iterFsr < PROTOCOL_FSR_NUMBER ; iterFsr++)
+    {
+        if (fsrValues[iterFsr] < sEpoch->min[iterFsr])
+            sEpoch->min[iterFsr] = fsrValues[iterFsr];
+        if (fsrValues[iterFsr] > sEpoch->max[iterFsr])
+            sEpoch->max[iterFsr] = fsrValues[iterFsr];
+        sEpoch->sum[iterFsr] += fsrValues[iterFsr];
+
+        diff = (fsrValues[iterFsr] > sEpoch->last[iterFsr]) ? fsrValues[iterFsr] - sEpoch->last[iterFsr] : sEpoch->last[iterFsr] - fsrValues[iterFsr];
+        diff *= diff;
+        /* Saturate instead of wrapping on very long epochs. */
+        sEpoch->sumSqDiff[iterFsr] = (sEpoch->sumSqDiff[iterFsr] > UINT32_MAX - diff) ? UINT32_MAX : sEpoch->sumSqDiff[iterFsr] + diff;
+        sEpoch->last[iterFsr] = fsrValues[iterFsr];
+    }
+
+    pressure_compute(fsrValues, &sPress);
+    bOccupied = (sPress.load >= PRESSURE_ENTRY_LOAD);
+    if (bOccupied)
+    {
+        /* Only the position along the bed is summarized. */
+        sEpoch->copSum += sPress.y;
+        if (sPress.y < sEpoch->copMin)
+            sEpoch->copMin = sPress.y;
+        if (sPress.y > sEpoch->copMax)
+            sEpoch->copMax = sPress.y;
+        sEpoch->nbOccupied++;
+    }
+    sEpoch->bLastOccupied = bOccupied;
+
+    sEpoch->nbSweeps++;
+
+    return (time - sEpoch->start >= EPOCH_LENGTH || sEpoch->nbSweeps == UINT16_MAX);
+}
+
+void epoch_getSummary(struct sEpochAggregator* sEpoch, struct sProtocolEPO* sEpo)
+{
+    uint32_t energy;
+    uint8_t iterFsr;
+
+    assert(sEpoch != NULL);
+    assert(sEpo != NULL);
+    assert(sEpoch->nbSweeps > 0);
+
+    sEpo->time      = sEpoch->start;
+    sEpo->nbSweeps  = sEpoch->nbSweeps;
+    sEpo->occupancy = ((uint32_t)sEpoch->nbOccupied * 255) / sEpoch->nbSweeps;
+    sEpo->flags     = 0;
+    if (sEpoch->nbOccupied > 0)
+        sEpo->flags |= cProtocolOccupancyAny;
+    if (sEpoch->nbOccupied == sEpoch->nbSweeps)
+        sEpo->flags |= cProtocolOccupancyAll;
+    if (sEpoch->bLastOccupied)
+        sEpo->flags |= cProtocolOccupancyLast;
+
+    if (sEpoch->nbOccupied > 0)
+    {
+        sEpo->copMean  = sEpoch->copSum / sEpoch->nbOccupied;
+        sEpo->copShift = sEpoch->copMax - sEpoch->copMin;
+    }
+    else
+        sEpo->copMean = sEpo->copShift = 0;
+
+    for (iterFsr = 0 ; iterFsr < PROTOCOL_FSR_NUMBER ; iterFsr++)
+    {
+        sEpo->min[iterFsr]  = sEpoch->min[iterFsr];
+        sEpo->max[iterFsr]  = sEpoch->max[iterFsr];
+        sEpo->mean[iterFsr] = sEpoch->sum[iterFsr] / sEpoch->nbSweeps;
+        energy = (sEpoch->nbSweeps > 1) ? sEpoch->sumSqDiff[iterFsr] / (sEpoch->nbSweeps - 1) : 0;
+        sEpo->energy[iterFsr] = (energy > UINT16_MAX) ? UINT16_MAX : energy;
+    }
+
+    sEpoch->nbSweeps = 0;
+}
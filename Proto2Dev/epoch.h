@@ -0,0 +1,97 @@
+/**
+ *  Bed sensor's epoch aggregator.
+ *
+ *  Summarizes FSR's sweeps over fixed length epochs : per channel
+ *  minimum, maximum, mean and movement energy, center of pressure's
+ *  shift and bed's occupancy. The aggregation is incremental and
+ *  its memory footprint doesn't depend on the epoch length.
+ *
+ *  @file epoch.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef EPOCH_H
+ #define EPOCH_H
+
+ #include <inttypes.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+ #include "pressure.h"
+
+ /**
+  *	Length of an epoch in ms.
+  */
+ #define EPOCH_LENGTH               30000
+
+ /**
+  *	State of an epoch aggregator.
+  */
+ struct sEpochAggregator
+ {
+    uint32_t start;                             /**< Time of the first sweep of the epoch from millis(). */
+    uint32_t sum[PROTOCOL_FSR_NUMBER];          /**< Sum of the values of each FSR. */
+    uint32_t sumSqDiff[PROTOCOL_FSR_NUMBER];    /**< Sum of the square differences between consecutive sweeps. */
+    uint16_t min[PROTOCOL_FSR_NUMBER];          /**< Minimum of each FSR. */
+    uint16_t max[PROTOCOL_FSR_NUMBER];          /**< Maximum of each FSR. */
+    uint16_t last[PROTOCOL_FSR_NUMBER];         /**< Previous sweep. */
+    uint32_t copSum;                            /**< Sum of the centers of pressure along the bed of occupied sweeps. */
+    int16_t  copMin;                            /**< Minimum center of pressure along the bed. */
+    int16_t  copMax;                            /**< Maximum center of pressure along the bed. */
+    uint16_t nbSweeps;                          /**< Number of sweeps in the epoch. */
+    uint16_t nbOccupied;                        /**< Number of occupied sweeps in the epoch. */
+    bool     bLastOccupied;                     /**< true if the bed was occupied during the last sweep. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Initializes an epoch aggregator.
+  *
+  *  @param [out] sEpoch
+  *      Reference to the aggregator.
+  */
+ void epoch_init(struct sEpochAggregator* sEpoch);
+
+ /**
+  *	Adds a sweep of FSR's to the current epoch.
+  *
+  *  @param [in,out] sEpoch
+  *      Reference to the aggregator.
+  *  @param [in] fsrValues
+  *      Sweep of FSR's.
+  *  @param [in] time
+  *      Time of the sweep from millis().
+  *
+  *  @return true if the epoch is complete, false otherwise.
+  *
+  *  @see epoch_getSummary()
+  */
+ bool epoch_update(struct sEpochAggregator* sEpoch, uint16_t const fsrValues[PROTOCOL_FSR_NUMBER], const uint32_t time);
+
+ /**
+  *	Computes the summary of the current epoch and starts a new one.
+  *
+  *  @param [in,out] sEpoch
+  *      Reference to the aggregator.
+  *  @param [out] sEpo
+  *      Reference to the container where store the summary.
+  *
+  *  @see protocol_createEPO()
+  */
+ void epoch_getSummary(struct sEpochAggregator* sEpoch, struct sProtocolEPO* sEpo);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,226 @@
+/**
+ *  @copybrief goertzel.h
+ *  @copydetails goertzel.h
+ *
+ *  @file goertzel.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "goertzel.h"
+
+/**
+ *	Sums a wave of FSC's sampling in fixed point.
+ *
+ *  @internal
+ *
+ *  @param [in] fscValues
+ *      Wave of FSC's sampling.
+ *
+ *  @return The sum with 8 fractional bits.
+ */
+static int32_t goertzel_input(uint16_t const fscValues[PROTOCOL_FSC_NUMBER]);
+
+/**
+ *	Removes the running mean from a sample.
+ *
+ *  @internal
+ *
+ *  @param [in,out] mean
+ *      Reference to the running mean.
+ *  @param [in,out] bPrimed
+ *      Reference to the initialization flag of the running mean.
+ *  @param [in] value
+ *      Sample from goertzel_input().
+ *
+ *  @return The centered sample.
+ */
+static int32_t goertzel_center(int32_t* mean, bool* bPrimed, const int32_t value);
+
+/**
+ *	Computes the power of a bin at the end of a block.
+ *
+ *  @internal
+ *
+ *  @param [in] sBank
+ *      Reference to the filter bank.
+ *  @param [in] bin
+ *      Index of the bin [0;PROTOCOL_SPC_BIN_NUMBER[.
+ *
+ *  @return The power of the bin.
+ */
+static int64_t goertzel_power(struct sGoertzelBank const* sBank, const uint8_t bin);
+
+int16_t const goertzel_coeff[PROTOCOL_SPC_BIN_NUMBER] PROGMEM = {32703, /* 0.10 Hz */
+                                                        32623, /* 0.15 Hz */
+                                                        32510, /* 0.20 Hz */
+                                                        32365, /* 0.25 Hz */
+                                                        32188, /* 0.30 Hz */
+                                                        31979, /* 0.35 Hz */
+                                                        31739, /* 0.40 Hz */
+                                                        31467, /* 0.45 Hz */
+                                                        31164, /* 0.50 Hz */
+                                                        30831, /* 0.55 Hz */
+                                                        30467, /* 0.60 Hz */
+                                                        30073  /* 0.65 Hz */
+                                                        };
+
+static int32_t goertzel_input(uint16_t const fscValues[PROTOCOL_FSC_NUMBER])
+{
+    int32_t value;
+    uint8_t iterFsc;
+
+    value = 0;
+    for (iterFsc = 0 ; iterFsc < PROTOCOL_FSC_NUMBER ; iterFsc++)
+        value += fscValues[iterFsc];
+
+    return value << 8;
+}
+
+static int32_t goertzel_center(int32_t* mean, bool* bPrimed, const int32_t value)
+{
+    if (!*bPrimed)
+    {
+        *mean = value;
+        *bPrimed = true;
+    }
+    *mean += (value - *mean) >> GOERTZEL_MEAN_SHIFT;
+
+    return (value - *mean) >> 8;
+}
+
+static int64_t goertzel_power(struct sGoertzelBank const* sBank, const uint8_t bin)
+{
+    int64_t s1;
+    int64_t s2;
+    int64_t power;
+
+    s1 = sBank->s1[bin];
+    s2 = sBank->s2[bin];
+    power = s1 * s1 + s2 * s2 - ((((int16_t)progmem_readWord(&goertzel_coeff[bin]) * s1) >> GOERTZEL_COEFF_BITS) * s2);
+
+    return (power < 0) ? 0 : power;
+}
+
+bool goertzel_init(struct sGoertzelBank* sBank, const uint32_t period)
+{
+    uint8_t iterBin;
+
+    assert(sBank != NULL);
+
+    for (iterBin = 0 ; iterBin < PROTOCOL_SPC_BIN_NUMBER ; iterBin++)
+        sBank->s1[iterBin] = sBank->s2[iterBin] = 0;
+    sBank->mean      = 0;
+    sBank->nbSamples = 0;
+    sBank->bPrimed   = false;
+    sBank->bEnabled  = (period == GOERTZEL_PERIOD);
+
+    return sBank->bEnabled;
+}
+
+bool goertzel_update(struct sGoertzelBank* sBank, uint16_t const fscValues[PROTOCOL_FSC_NUMBER])
+{
+    int32_t x;
+    int32_t s;
+    uint8_t iterBin;
+
+    assert(sBank != NULL);
+    assert(fscValues != NULL);
+
+    if (!sBank->bEnabled)
+        return false;
+
+    x = goertzel_center(&(sBank->mean), &(sBank->bPrimed), goertzel_input(fscValues));
+
+    for (iterBin = 0 ; iterBin < PROTOCOL_SPC_BIN_NUMBER ; iterBin++)
+    {
+        s = x + (int32_t)(((int64_t)(int16_t)progmem_readWord(&goertzel_coeff[iterBin]) * sBank->s1[iterBin]) >> GOERTZEL_COEFF_BITS) - sBank->s2[iterBin];
+        sBank->s2[iterBin] = sBank->s1[iterBin];
+        sBank->s1[iterBin] = s;
+    }
+
+    sBank->nbSamples++;
+
+    return (sBank->nbSamples >= GOERTZEL_BLOCK_SAMPLES);
+}
+
+bool goertzel_updateBlock(struct sGoertzelBank* sBank, uint16_t const fscValues[][PROTOCOL_FSC_NUMBER], const uint16_t nbWaves)
+{
+    int32_t mean;
+    int32_t s;
+    int32_t s1;
+    int32_t s2;
+    int64_t coeff;
+    bool bPrimed;
+    uint16_t iterWave;
+    uint8_t iterBin;
+
+    assert(sBank != NULL);
+    assert(fscValues != NULL);
+    assert(sBank->nbSamples + nbWaves <= GOERTZEL_BLOCK_SAMPLES);
+
+    if (!sBank->bEnabled)
+        return false;
+
+    /* The running mean is replayed for each bin instead of buffering centered samples. */
+    for (iterBin = 0 ; iterBin < PROTOCOL_SPC_BIN_NUMBER ; iterBin++)
+    {
+        mean    = sBank->mean;
+        bPrimed = sBank->bPrimed;
+        coeff   = (int16_t)progmem_readWord(&goertzel_coeff[iterBin]);
+        s1      = sBank->s1[iterBin];
+        s2      = sBank->s2[iterBin];
+        for (iterWave = 0 ; iterWave < nbWaves ; iterWave++)
+        {
+            s  = goertzel_center(&mean, &bPrimed, goertzel_input(fscValues[iterWave]));
+            s += (int32_t)((coeff * s1) >> GOERTZEL_COEFF_BITS) - s2;
+            s2 = s1;
+            s1 = s;
+        }
+        sBank->s1[iterBin] = s1;
+        sBank->s2[iterBin] = s2;
+    }
+    if (nbWaves > 0)
+    {
+        sBank->mean    = mean;
+        sBank->bPrimed = bPrimed;
+    }
+
+    sBank->nbSamples += nbWaves;
+
+    return (sBank->nbSamples >= GOERTZEL_BLOCK_SAMPLES);
+}
+
+void goertzel_getSpectrum(struct sGoertzelBank* sBank, struct sProtocolSPC* sSpc)
+{
+    int64_t power;
+    int64_t max;
+    uint8_t iterBin;
+
+    assert(sBank != NULL);
+    assert(sSpc != NULL);
+
+    /* Block floating point : shared exponent for the biggest bin to fit. */
+    max = 0;
+    for (iterBin = 0 ; iterBin < PROTOCOL_SPC_BIN_NUMBER ; iterBin++)
+    {
+        power = goertzel_power(sBank, iterBin);
+        if (power > max)
+            max = power;
+    }
+    sSpc->exponent = 0;
+    while ((max >> sSpc->exponent) > UINT16_MAX)
+        sSpc->exponent++;
+
+    for (iterBin = 0 ; iterBin < PROTOCOL_SPC_BIN_NUMBER ; iterBin++)
+    {
+        sSpc->power[iterBin] = goertzel_power(sBank, iterBin) >> sSpc->exponent;
+        /* Next block. */
+        sBank->s1[iterBin] = sBank->s2[iterBin] = 0;
+    }
+
+    sBank->nbSamples = 0;
+}
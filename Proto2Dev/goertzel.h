@@ -0,0 +1,142 @@
+/**
+ *  Goertzel filter bank for the breathing band.
+ *
+ *  Computes the power of PROTOCOL_SPC_BIN_NUMBER frequency bins between
+ *  0.10 Hz and 0.65 Hz (0.05 Hz step) over blocks of FSC's sampling waves.
+ *  Each wave updates every bins in O(bins) without buffering samples,
+ *  so the bank can run on the bed sensor along the acquisition.
+ *
+ *  Only integer arithmetic is used so the bed sensor and a host
+ *  processing archived nights give bit-exact results.
+ *
+ *  @file goertzel.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef GOERTZEL_H
+ #define GOERTZEL_H
+
+ #include <inttypes.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+
+ /**
+  *	Sampling rate of the FSC's waves in mHz expected by the coefficients.
+  *
+  *  @warning goertzel_coeff must be computed again if it changes.
+  */
+ #define GOERTZEL_SAMPLE_RATE       10000
+ /**
+  *	Period of the FSC's waves in ms matching GOERTZEL_SAMPLE_RATE.
+  */
+ #define GOERTZEL_PERIOD            (1000000UL / GOERTZEL_SAMPLE_RATE)
+ /**
+  *	Number of sampling waves in an analysis block.
+  *
+  *  @note 256 waves at 10 Hz give a resolution of 0.04 Hz.
+  */
+ #define GOERTZEL_BLOCK_SAMPLES     256
+ /**
+  *	Number of fractional bits of the coefficients.
+  */
+ #define GOERTZEL_COEFF_BITS        14
+ /**
+  *	Shift of the exponential filter removing the signal's mean.
+  */
+ #define GOERTZEL_MEAN_SHIFT        5
+
+ /**
+  *	State of a Goertzel filter bank.
+  */
+ struct sGoertzelBank
+ {
+    int32_t  s1[PROTOCOL_SPC_BIN_NUMBER];   /**< Filter's output at n - 1 for each bin. */
+    int32_t  s2[PROTOCOL_SPC_BIN_NUMBER];   /**< Filter's output at n - 2 for each bin. */
+    int32_t  mean;                          /**< Running mean of the input, 8 fractional bits. */
+    uint16_t nbSamples;                     /**< Number of sampling waves in the current block. */
+    bool     bPrimed;                       /**< true once the running mean is initialized. */
+    bool     bEnabled;                      /**< true if the waves' period matches the coefficients. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Table of coefficients 2cos(2 pi f / fs) of the bins, in program memory.
+  */
+ extern int16_t const goertzel_coeff[PROTOCOL_SPC_BIN_NUMBER] PROGMEM;
+
+ /**
+  *	Initializes a filter bank.
+  *
+  *  The bins are only valid at GOERTZEL_SAMPLE_RATE : for any other period
+  *  the bank is disabled and never completes a block.
+  *
+  *  @param [out] sBank
+  *      Reference to the filter bank.
+  *  @param [in] period
+  *      Period of the FSC's waves in ms.
+  *
+  *  @return true if the bank is enabled, false otherwise.
+  */
+ bool goertzel_init(struct sGoertzelBank* sBank, const uint32_t period);
+
+ /**
+  *	Feeds a wave of FSC's sampling to the filter bank.
+  *
+  *  @param [in,out] sBank
+  *      Reference to the filter bank.
+  *  @param [in] fscValues
+  *      Wave of FSC's sampling.
+  *
+  *  @return true if an analysis block is complete, false otherwise or
+  *      if the bank is disabled.
+  *
+  *  @see goertzel_getSpectrum()
+  */
+ bool goertzel_update(struct sGoertzelBank* sBank, uint16_t const fscValues[PROTOCOL_FSC_NUMBER]);
+
+ /**
+  *	Feeds multiple waves of FSC's sampling to the filter bank.
+  *
+  *  Gives the same result than successive calls to goertzel_update() but
+  *  loops over samples for each bin, which suits batch processing on a host.
+  *
+  *  @param [in,out] sBank
+  *      Reference to the filter bank.
+  *  @param [in] fscValues
+  *      Waves of FSC's sampling sort by time of acquisition.
+  *  @param [in] nbWaves
+  *      Number of waves, the current block must not overflow.
+  *
+  *  @return true if an analysis block is complete, false otherwise.
+  */
+ bool goertzel_updateBlock(struct sGoertzelBank* sBank, uint16_t const fscValues[][PROTOCOL_FSC_NUMBER], const uint16_t nbWaves);
+
+ /**
+  *	Computes the power of the bins and starts a new block.
+  *
+  *  @param [in,out] sBank
+  *      Reference to the filter bank.
+  *  @param [out] sSpc
+  *      Reference to the container where store the spectrum.
+  *      The time field isn't modified.
+  *
+  *  @see protocol_createSPC()
+  */
+ void goertzel_getSpectrum(struct sGoertzelBank* sBank, struct sProtocolSPC* sSpc);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
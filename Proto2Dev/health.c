@@ -0,0 +1,111 @@
+/**
+ *  @copybrief health.h
+ *  @copydetails health.h
+ *
+ *  @file health.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "health.h"
+
+void health_init(struct sHealthTracker* sHealth)
+{
+    assert(sHealth != NULL);
+
+    memset(sHealth, 0, sizeof(*sHealth));
+}
+
+uint16_t health_update(struct sHealthTracker* sHealth, uint16_t const fsrValues[PROTOCOL_FSR_NUMBER], const uint16_t mask)
+{
+    uint8_t iter;
+    uint8_t inUse;
+    uint8_t loaded;
+    uint16_t bit;
+    uint16_t change;
+    bool bLoaded;
+
+    assert(sHealth != NULL);
+    assert(fsrValues != NULL);
+
+    /* A disconnected cell is told from an unloaded one by the load of the others only. */
+    for (iter = 0, bit = 1, inUse = 0, loaded = 0 ; iter < PROTOCOL_FSR_NUMBER ; iter++, bit <<= 1)
+    {
+        if ((mask & bit) == 0)
+            continue;
+        inUse++;
+        if (fsrValues[iter] >= HEALTH_LOAD_LEVEL)
+            loaded++;
+    }
+    bLoaded = (loaded > 0 && 2 * loaded >= inUse);
+
+    for (iter = 0, bit = 1 ; iter < PROTOCOL_FSR_NUMBER ; iter++, bit <<= 1)
+    {
+        if ((mask & bit) == 0)
+        {
+            /* Checked from scratch once back in use. */
+            sHealth->still[iter] = sHealth->floor[iter] = sHealth->saturated[iter] = 0;
+            sHealth->faulty &= ~bit;
+            continue;
+        }
+
+        if (fsrValues[iter] >= HEALTH_SATURATION)
+        {
+            if (sHealth->saturated[iter] < HEALTH_SATURATED_RUN)
+                sHealth->saturated[iter]++;
+        }
+        else
+            sHealth->saturated[iter] = 0;
+
+        change = (fsrValues[iter] > sHealth->held[iter]) ? fsrValues[iter] - sHealth->held[iter] : sHealth->held[iter] - fsrValues[iter];
+        if (change > HEALTH_STILL_DELTA || fsrValues[iter] < HEALTH_IDLE_LEVEL)
+        {
+            sHealth->held[iter] = fsrValues[iter];
+            sHealth->still[iter] = 0;
+        }
+        else if (sHealth->still[iter] < HEALTH_STUCK_RUN)
+            sHealth->still[iter]++;
+
+        if (fsrValues[iter] >= HEALTH_IDLE_LEVEL)
+            sHealth->floor[iter] = 0;
+        else if (bLoaded && sHealth->floor[iter] < HEALTH_DISCONNECTED_RUN)
+            sHealth->floor[iter]++;
+
+        sHealth->faulty &= ~bit;
+        if (sHealth->saturated[iter] >= HEALTH_SATURATED_RUN)
+        {
+            sHealth->faulty |= bit;
+            sHealth->saturatedSeen |= bit;
+        }
+        /* A saturated channel holds its value too, reported once. */
+        else if (sHealth->still[iter] >= HEALTH_STUCK_RUN)
+        {
+            sHealth->faulty |= bit;
+            sHealth->stuckSeen |= bit;
+        }
+        else if (sHealth->floor[iter] >= HEALTH_DISCONNECTED_RUN)
+        {
+            sHealth->faulty |= bit;
+            sHealth->disconnectedSeen |= bit;
+        }
+    }
+
+    return sHealth->faulty;
+}
+
+void health_getReport(struct sHealthTracker* sHealth, struct sProtocolCHS* sChs)
+{
+    assert(sHealth != NULL);
+    assert(sChs != NULL);
+
+    sChs->stuck = sHealth->stuckSeen;
+    sChs->saturated = sHealth->saturatedSeen;
+    sChs->disconnected = sHealth->disconnectedSeen;
+    /* The faults still there are seen again at the next sweep. */
+    sHealth->stuckSeen = 0;
+    sHealth->saturatedSeen = 0;
+    sHealth->disconnectedSeen = 0;
+}
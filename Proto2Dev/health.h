@@ -0,0 +1,127 @@
+/**
+ *  Health of the FSR's channels.
+ *
+ *  Each sweep is checked before calibration, channel by channel, with run
+ *  lengths only. A shorted cell reads HEALTH_SATURATION : it's saturated
+ *  after HEALTH_SATURATED_RUN sweeps at this value in a row. A cell cut
+ *  from the ADC, or an ADC's input stuck, holds a value : it's stuck after
+ *  HEALTH_STUCK_RUN sweeps within HEALTH_STILL_DELTA of the first one, the
+ *  variance floor of a loaded cell which breathing and noise never reach.
+ *  An unloaded cell legitimately holds a value below HEALTH_IDLE_LEVEL and
+ *  is never stuck. A cell cut from its supply reads as an unloaded one : it's
+ *  disconnected after HEALTH_DISCONNECTED_RUN sweeps in a row below
+ *  HEALTH_IDLE_LEVEL while at least half of the channels in use are loaded,
+ *  the other sweeps keeping the count. A cell the body never reaches over
+ *  that long is reported too, being alike on the wire. A channel recovers
+ *  at its first sweep out of its fault.
+ *
+ *  The unhealthy channels read as out of use, so they trigger neither the
+ *  watch's activity detection nor the bed's events, and weigh nothing in
+ *  the summaries. The faults met over a period are reported in a CHS frame
+ *  along with the telemetry.
+ *
+ *  @file health.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef HEALTH_H
+ #define HEALTH_H
+
+ #include <inttypes.h>
+ #include <string.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+
+ /**
+  *	Raw value of a saturated channel, the greatest of the ADS7828.
+  */
+ #define HEALTH_SATURATION          4095
+ /**
+  *	Sweeps in a row at saturation revealing a shorted cell.
+  */
+ #define HEALTH_SATURATED_RUN       5
+ /**
+  *	Sweeps in a row holding a value revealing a stuck channel.
+  */
+ #define HEALTH_STUCK_RUN           300
+ /**
+  *	Greatest change of a value held, in raw units.
+  */
+ #define HEALTH_STILL_DELTA         1
+ /**
+  *	Raw values below which an unloaded cell holds its value.
+  */
+ #define HEALTH_IDLE_LEVEL          64
+ /**
+  *	Raw values from which a cell is loaded.
+  */
+ #define HEALTH_LOAD_LEVEL          512
+ /**
+  *	Sweeps in a row at the floor, the bed being loaded, revealing a disconnected cell.
+  */
+ #define HEALTH_DISCONNECTED_RUN    600
+
+ /**
+  *	State of the channels.
+  */
+ struct sHealthTracker
+ {
+    uint16_t held[PROTOCOL_FSR_NUMBER];         /**< Value held by each channel. */
+    uint16_t still[PROTOCOL_FSR_NUMBER];        /**< Sweeps in a row within HEALTH_STILL_DELTA of the value held. */
+    uint16_t floor[PROTOCOL_FSR_NUMBER];        /**< Sweeps of a loaded bed in a row below HEALTH_IDLE_LEVEL. */
+    uint8_t  saturated[PROTOCOL_FSR_NUMBER];    /**< Sweeps in a row at saturation. */
+    uint16_t faulty;                            /**< Unhealthy channels, bit i for channel i. */
+    uint16_t stuckSeen;                         /**< Channels stuck since the last report. */
+    uint16_t saturatedSeen;                     /**< Channels saturated since the last report. */
+    uint16_t disconnectedSeen;                  /**< Channels disconnected since the last report. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Starts with every channel healthy.
+  *
+  *  @param [out] sHealth
+  *      Reference to the state.
+  */
+ void health_init(struct sHealthTracker* sHealth);
+
+ /**
+  *	Checks a sweep.
+  *
+  *  @param [in,out] sHealth
+  *      Reference to the state.
+  *  @param [in] fsrValues
+  *      Raw values of the sweep, before calibration.
+  *  @param [in] mask
+  *      Channels in use, bit i for channel i, the others being neither checked nor unhealthy.
+  *
+  *  @return The unhealthy channels, bit i for channel i.
+  */
+ uint16_t health_update(struct sHealthTracker* sHealth, uint16_t const fsrValues[PROTOCOL_FSR_NUMBER], const uint16_t mask);
+
+ /**
+  *	Gives the faults met since the last report and starts a new period.
+  *
+  *  @param [in,out] sHealth
+  *      Reference to the state.
+  *  @param [out] sChs
+  *      Reference to the container, its time left to the caller.
+  */
+ void health_getReport(struct sHealthTracker* sHealth, struct sProtocolCHS* sChs);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
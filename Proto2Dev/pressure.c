@@ -0,0 +1,89 @@
+/**
+ *  @copybrief pressure.h
+ *  @copydetails pressure.h
+ *
+ *  @file pressure.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "pressure.h"
+
+/**
+ *	Position of each FSR across the bed in mm, in program memory.
+ *
+ *  @internal
+ */
+static int16_t const pressure_cellX[PROTOCOL_FSR_NUMBER] PROGMEM = PRESSURE_CELL_X;
+
+/**
+ *	Position of each FSR along the bed in mm, in program memory.
+ *
+ *  @internal
+ */
+static int16_t const pressure_cellY[PROTOCOL_FSR_NUMBER] PROGMEM = PRESSURE_CELL_Y;
+
+void pressure_compute(uint16_t const fsrValues[PROTOCOL_FSR_NUMBER], struct sPressure* sPress)
+{
+    uint32_t load;
+    int32_t momentX;
+    int32_t momentY;
+    uint8_t iterFsr;
+
+    assert(fsrValues != NULL);
+    assert(sPress != NULL);
+
+    load = 0;
+    momentX = momentY = 0;
+    for (iterFsr = 0 ; iterFsr < PROTOCOL_FSR_NUMBER ; iterFsr++)
+    {
+        load    += fsrValues[iterFsr];
+        momentX += (int32_t)fsrValues[iterFsr] * (int16_t)progmem_readWord(&pressure_cellX[iterFsr]);
+        momentY += (int32_t)fsrValues[iterFsr] * (int16_t)progmem_readWord(&pressure_cellY[iterFsr]);
+    }
+
+    sPress->load = (load > UINT16_MAX) ? UINT16_MAX : load;
+    if (load > 0)
+    {
+        sPress->x = momentX / (int32_t)load;
+        sPress->y = momentY / (int32_t)load;
+    }
+    else
+        sPress->x = sPress->y = 0;
+}
+
+void pressure_initDetector(struct sPressureDetector* sDetector, const bool bOccupied)
+{
+    assert(sDetector != NULL);
+
+    sDetector->bOccupied = bOccupied;
+    sDetector->nbChanges = 0;
+}
+
+eProtocolEvent pressure_detect(struct sPressureDetector* sDetector, struct sPressure const* sPress)
+{
+    eProtocolEvent event = cProtocolEventUnknow;
+    bool bChange;
+
+    assert(sDetector != NULL);
+    assert(sPress != NULL);
+
+    if (sDetector->bOccupied)
+        bChange = (sPress->load < PRESSURE_EXIT_LOAD);
+    else
+        bChange = (sPress->load >= PRESSURE_ENTRY_LOAD);
+
+    if (!bChange)
+        sDetector->nbChanges = 0;
+    else if (++sDetector->nbChanges >= PRESSURE_DEBOUNCE)
+    {
+        sDetector->bOccupied = !sDetector->bOccupied;
+        sDetector->nbChanges = 0;
+        event = sDetector->bOccupied ? cProtocolEventEntry : cProtocolEventExit;
+    }
+
+    return event;
+}
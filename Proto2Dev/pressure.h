@@ -0,0 +1,116 @@
+/**
+ *  Bed sensor's center of pressure and bed exit detection.
+ *
+ *  Computes the total load and the center of pressure of the FSR's array
+ *  from the position of each cell, then detects when a person lies on
+ *  or leaves the bed with an hysteresis on the load.
+ *
+ *  @file pressure.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef PRESSURE_H
+ #define PRESSURE_H
+
+ #include <inttypes.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+
+ /**
+  *	Position of each FSR across the bed in mm, sort by channel.
+  *
+  *  @note Default layout : two columns of four cells.
+  */
+ #ifndef PRESSURE_CELL_X
+  #define PRESSURE_CELL_X           {225, 675, 225, 675, 225, 675, 225, 675}
+ #endif
+ /**
+  *	Position of each FSR along the bed in mm, sort by channel.
+  */
+ #ifndef PRESSURE_CELL_Y
+  #define PRESSURE_CELL_Y           {300, 300, 700, 700, 1100, 1100, 1500, 1500}
+ #endif
+ /**
+  *	Minimum total load for the bed to become occupied.
+  */
+ #define PRESSURE_ENTRY_LOAD        1024
+ /**
+  *	Maximum total load for the bed to become empty.
+  *
+  *  @note Lower than PRESSURE_ENTRY_LOAD to avoid flapping.
+  */
+ #define PRESSURE_EXIT_LOAD         512
+ /**
+  *	Number of consecutive sweeps confirming a change of occupancy.
+  */
+ #define PRESSURE_DEBOUNCE          2
+
+ /**
+  *	Pressure applied on the bed during a sweep.
+  */
+ struct sPressure
+ {
+    uint16_t load;                  /**< Sum of the FSR's. */
+    int16_t  x;                     /**< Center of pressure across the bed in mm, 0 without load. */
+    int16_t  y;                     /**< Center of pressure along the bed in mm, 0 without load. */
+ };
+
+ /**
+  *	State of a bed exit detector.
+  */
+ struct sPressureDetector
+ {
+    bool     bOccupied;             /**< Confirmed occupancy of the bed. */
+    uint8_t  nbChanges;             /**< Number of consecutive sweeps contradicting bOccupied. */
+ };
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Computes the total load and the center of pressure of a sweep.
+  *
+  *  @param [in] fsrValues
+  *      Sweep of FSR's.
+  *  @param [out] sPress
+  *      Reference where store the result.
+  */
+ void pressure_compute(uint16_t const fsrValues[PROTOCOL_FSR_NUMBER], struct sPressure* sPress);
+
+ /**
+  *	Initializes a bed exit detector.
+  *
+  *  @param [out] sDetector
+  *      Reference to the detector.
+  *  @param [in] bOccupied
+  *      Initial occupancy of the bed.
+  */
+ void pressure_initDetector(struct sPressureDetector* sDetector, const bool bOccupied);
+
+ /**
+  *	Updates a bed exit detector with a sweep.
+  *
+  *  @param [in,out] sDetector
+  *      Reference to the detector.
+  *  @param [in] sPress
+  *      Pressure of the sweep.
+  *
+  *  @return cProtocolEventExit or cProtocolEventEntry on a confirmed change,
+  *          cProtocolEventUnknow otherwise.
+  */
+ eProtocolEvent pressure_detect(struct sPressureDetector* sDetector, struct sPressure const* sPress);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,225 @@
+/**
+ *  @copybrief probe.h
+ *  @copydetails probe.h
+ *
+ *  @file probe.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "probe.h"
+
+#if defined(__AVR__)
+ #include <avr/io.h>
+ #include <avr/interrupt.h>
+#elif defined(__i386__) || defined(__x86_64__)
+ #include <x86intrin.h>
+#else
+ #error "No counter for the probes on this target"
+#endif
+
+/**
+ *	Statistics of a timed section.
+ *
+ *  @internal
+ */
+struct sProbeStats
+{
+    uint16_t count;                                 /**< Number of runs. */
+    uint32_t min;                                   /**< Shortest run in ticks. */
+    uint32_t max;                                   /**< Longest run in ticks. */
+    uint16_t buckets[PROTOCOL_STA_BUCKET_NUMBER];   /**< Number of runs in each bucket. */
+};
+
+/**
+ *	Statistics of the timed sections and health counters since the last summary.
+ *
+ *  @internal
+ */
+static struct sProbeStats probe_stats[cProbeNumber];
+static uint16_t probe_counters[cProbeCounterNumber];
+
+#if defined(__AVR__)
+/**
+ *	Overflows of Timer1, high word of the counter.
+ *
+ *  @internal
+ */
+static volatile uint16_t probe_overflows = 0;
+
+ISR(TIMER1_OVF_vect)
+{
+    probe_overflows++;
+}
+
+/**
+ *	Bounds of the SRAM left to the heap and the stack, given by the linker.
+ *
+ *  @internal
+ */
+extern uint8_t _end;
+extern uint8_t __stack;
+
+/**
+ *	Paints the SRAM between the static variables and the stack.
+ *
+ *  @internal
+ *
+ *  @note Runs from .init1, before the C runtime : no stack, registers only.
+ */
+void probe_paintStack(void) __attribute__ ((naked, used, section (".init1")));
+
+void probe_paintStack(void)
+{
+    __asm volatile ("    ldi r30, lo8(_end)\n"
+                    "    ldi r31, hi8(_end)\n"
+                    "    ldi r24, %0\n"
+                    "    ldi r25, hi8(__stack)\n"
+                    "    rjmp 2f\n"
+                    "1:  st Z+, r24\n"
+                    "2:  cpi r30, lo8(__stack)\n"
+                    "    cpc r31, r25\n"
+                    "    brlo 1b\n"
+                    "    breq 1b\n"
+                    :: "M" (PROBE_STACK_CANARY));
+}
+#endif
+
+/**
+ *	Clears every statistics.
+ *
+ *  @internal
+ */
+static void probe_clear(void);
+
+static void probe_clear(void)
+{
+    uint8_t iter;
+
+    memset(probe_stats, 0, sizeof(probe_stats));
+    memset(probe_counters, 0, sizeof(probe_counters));
+    for (iter = 0 ; iter < cProbeNumber ; iter++)
+        probe_stats[iter].min = UINT32_MAX;
+}
+
+void probe_init(void)
+{
+#if defined(__AVR__)
+    /* Normal mode, no prescaler : one tick per CPU cycle. */
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TCNT1 = 0;
+    TIFR1 = _BV(TOV1);
+    TIMSK1 |= _BV(TOIE1);
+#endif
+    probe_clear();
+}
+
+uint32_t probe_now(void)
+{
+#if defined(__AVR__)
+    uint8_t sreg;
+    uint16_t high;
+    uint16_t low;
+
+    sreg = SREG;
+    cli();
+    high = probe_overflows;
+    low = TCNT1;
+    /* An overflow not handled yet, the counter having wrapped. */
+    if ((TIFR1 & _BV(TOV1)) && low < 0x8000)
+        high++;
+    SREG = sreg;
+
+    return ((uint32_t)high << 16) | low;
+#else
+    return (uint32_t)__rdtsc();
+#endif
+}
+
+void probe_record(const eProbe probe, const uint32_t start)
+{
+    struct sProbeStats* sStats;
+    uint32_t ticks;
+    uint32_t us;
+    uint8_t bucket;
+
+    assert(probe < cProbeNumber);
+
+    ticks = probe_now() - start;
+    sStats = &probe_stats[probe];
+    if (sStats->count < UINT16_MAX)
+        sStats->count++;
+    if (ticks < sStats->min)
+        sStats->min = ticks;
+    if (ticks > sStats->max)
+        sStats->max = ticks;
+    /* Four times longer for each bucket. */
+    us = ticks / PROBE_TICKS_PER_US;
+    us >>= PROBE_BUCKET_SHIFT;
+    for (bucket = 0 ; us != 0 && bucket < PROTOCOL_STA_BUCKET_NUMBER - 1 ; bucket++)
+        us >>= 2;
+    if (sStats->buckets[bucket] < UINT16_MAX)
+        sStats->buckets[bucket]++;
+}
+
+void probe_count(const eProbeCounter counter)
+{
+    assert(counter < cProbeCounterNumber);
+
+    if (probe_counters[counter] < UINT16_MAX)
+        probe_counters[counter]++;
+}
+
+uint16_t probe_getStackFree(void)
+{
+#if defined(__AVR__)
+    uint8_t const* p;
+    uint16_t size;
+
+    /* The stack grows down to the static variables. */
+    p = &_end;
+    size = 0;
+    while (p <= &__stack && *p == PROBE_STACK_CANARY)
+    {
+        p++;
+        size++;
+    }
+
+    return size;
+#else
+    return UINT16_MAX;
+#endif
+}
+
+void probe_getSummary(struct sProtocolSTA* sSta)
+{
+    uint8_t iter;
+    uint8_t bucket;
+    struct sProbeStats const* sStats;
+
+    assert(sSta != NULL);
+    assert(cProbeNumber <= PROTOCOL_STA_PROBE_NUMBER);
+    assert(cProbeCounterNumber <= PROTOCOL_STA_COUNTER_NUMBER);
+
+    memset(sSta->counters, 0, sizeof(sSta->counters));
+    memset(sSta->probes, 0, sizeof(sSta->probes));
+    memcpy(sSta->counters, probe_counters, sizeof(probe_counters));
+    sSta->stackFree = probe_getStackFree();
+    sSta->busDelay = 0;
+    for (iter = 0 ; iter < cProbeNumber ; iter++)
+    {
+        sStats = &probe_stats[iter];
+        sSta->probes[iter].count = sStats->count;
+        if (sStats->count == 0)
+            continue;
+        sSta->probes[iter].min = sStats->min / PROBE_TICKS_PER_US;
+        sSta->probes[iter].max = sStats->max / PROBE_TICKS_PER_US;
+        for (bucket = 0 ; bucket < PROTOCOL_STA_BUCKET_NUMBER ; bucket++)
+            sSta->probes[iter].share[bucket] = (uint8_t)(((uint32_t)sStats->buckets[bucket] * UINT8_MAX) / sStats->count);
+    }
+    probe_clear();
+}
@@ -0,0 +1,140 @@
+/**
+ *  Lightweight instrumentation of the bed sensor.
+ *
+ *  Timed sections (probes) are measured with a free running counter : the
+ *  16 bits Timer1 at the CPU clock extended by its overflows on the AVR,
+ *  the time stamp counter (rdtsc) on a x86 host, so a simulation reports
+ *  the same metrics. Each probe keeps its count, its extremes and a
+ *  histogram of its durations, and health counters count the failures.
+ *  Everything is summed up in a STA frame once per period, then restarted.
+ *
+ *  On the AVR, the free SRAM is painted with PROBE_STACK_CANARY before
+ *  main(), so the part of it never reached by the stack is known at any
+ *  time : the room left for larger buffers.
+ *
+ *  @file probe.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef PROBE_H
+ #define PROBE_H
+
+ #include <inttypes.h>
+ #include <string.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+
+ /**
+  *	Number of ticks of the counter per us.
+  */
+ #ifndef PROBE_TICKS_PER_US
+  #if defined(__AVR__)
+   #define PROBE_TICKS_PER_US       ((F_CPU) / 1000000UL)
+  #else
+   /* Nominal 1 GHz time stamp counter, to be set by the simulation. */
+   #define PROBE_TICKS_PER_US       1000
+  #endif
+ #endif
+ /**
+  *	Duration of the first bucket of the histograms in us, as a power of two.
+  */
+ #define PROBE_BUCKET_SHIFT         6
+ /**
+  *	Value painted in the free SRAM at startup.
+  */
+ #define PROBE_STACK_CANARY         0xC5
+
+ /**
+  *	Enumeration of the timed sections.
+  */
+ typedef enum
+ {
+    cProbeSweep = 0,    /**< Sweep of the FSR's ADC. */
+    cProbeSample,       /**< Whole handling of a sample : sweep, processing and encoding. */
+    cProbeSend,         /**< Radio packet on the serial link, with its delivery out of a burst. */
+    cProbeSpool,        /**< Access to the spool in the 24XX1026 memory. */
+    /* ^-insert new probe at the end-^ */
+    /*-------END OF ENUMERATION------*/
+    cProbeNumber        /**< Number of probes, PROTOCOL_STA_PROBE_NUMBER at most. */
+ } eProbe;
+
+ /**
+  *	Enumeration of the health counters.
+  */
+ typedef enum
+ {
+    cProbeCounterI2c = 0,   /**< Failed I2C transactions with the ADC. */
+    cProbeCounterFull,      /**< Acquisitions stopped by a full buffer. */
+    cProbeCounterLate,      /**< Tasks run a period or more after their deadline. */
+    cProbeCounterDropped,   /**< Frames dropped by the transmit scheduler. */
+    /* ^-insert new counter at the end-^ */
+    /*--------END OF ENUMERATION--------*/
+    cProbeCounterNumber     /**< Number of counters, PROTOCOL_STA_COUNTER_NUMBER at most. */
+ } eProbeCounter;
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Starts the counter and clears every statistics.
+  *
+  *  @warning On the AVR, Timer1 is taken : no PWM on pins 9 and 10.
+  */
+ void probe_init(void);
+
+ /**
+  *	Reads the counter.
+  *
+  *  @return The number of ticks, wrapping.
+  */
+ uint32_t probe_now(void);
+
+ /**
+  *	Records the end of a timed section.
+  *
+  *  @param [in] probe
+  *      The section.
+  *  @param [in] start
+  *      Ticks at its start, from probe_now().
+  */
+ void probe_record(const eProbe probe, const uint32_t start);
+
+ /**
+  *	Increments a health counter, saturated.
+  *
+  *  @param [in] counter
+  *      The counter.
+  */
+ void probe_count(const eProbeCounter counter);
+
+ /**
+  *	Measures the SRAM never reached by the stack since startup.
+  *
+  *  @return The size in bytes, UINT16_MAX on a host.
+  */
+ uint16_t probe_getStackFree(void);
+
+ /**
+  *	Sums up the statistics since the last call and clears them.
+  *
+  *  @param [out] sSta
+  *      Reference where store the statistics and the free SRAM, but the time and the bus delay.
+  *
+  *  @see protocol_createSTA()
+  */
+ void probe_getSummary(struct sProtocolSTA* sSta);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,65 @@
+/**
+ *  Constant tables and strings in program memory.
+ *
+ *  On the AVR, constants declared PROGMEM stay in flash instead of being
+ *  copied in SRAM at startup, and must be read through the functions of
+ *  avr/pgmspace.h. On a host these accessors are plain memory accesses,
+ *  so the same code runs in both builds.
+ *
+ *  @file progmem.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef PROGMEM_H
+ #define PROGMEM_H
+
+ #include <inttypes.h>
+ #include <string.h>
+
+ #if defined(__AVR__)
+  #include <avr/pgmspace.h>
+
+  #define progmem_readByte(addr)            pgm_read_byte(addr)
+  #define progmem_readWord(addr)            pgm_read_word(addr)
+  #define progmem_readDword(addr)           pgm_read_dword(addr)
+  #define progmem_memcpy(dest, src, n)      memcpy_P((dest), (src), (n))
+  #define progmem_strncmp(str, pstr, n)     strncmp_P((str), (pstr), (n))
+ #else
+  #ifndef PROGMEM
+   #define PROGMEM
+  #endif
+  #ifndef PSTR
+   #define PSTR(str)                        (str)
+  #endif
+
+  /**
+   * @def    progmem_readByte(addr)
+   * @brief  Reads a byte of program memory.
+   */
+  #define progmem_readByte(addr)            (*(uint8_t const*)(addr))
+  /**
+   * @def    progmem_readWord(addr)
+   * @brief  Reads 2 bytes of program memory, in host order.
+   */
+  #define progmem_readWord(addr)            (*(uint16_t const*)(addr))
+  /**
+   * @def    progmem_readDword(addr)
+   * @brief  Reads 4 bytes of program memory, in host order.
+   */
+  #define progmem_readDword(addr)           (*(uint32_t const*)(addr))
+  /**
+   * @def    progmem_memcpy(dest, src, n)
+   * @brief  Copies n bytes of program memory in SRAM.
+   */
+  #define progmem_memcpy(dest, src, n)      memcpy((dest), (src), (n))
+  /**
+   * @def    progmem_strncmp(str, pstr, n)
+   * @brief  Compares a string in SRAM with a string in program memory.
+   */
+  #define progmem_strncmp(str, pstr, n)     strncmp((str), (pstr), (n))
+ #endif
+#endif
@@ -77,6 +77,20 @@ static void protocol_readFSC(uint16_t* fscValues);
  */
 static void protocol_readFSR(uint16_t* fsrValues);
 
+/**
+ *	Read the header of a DCN or DAN frame from set stream.
+ *  
+ *  @internal
+ *  
+ *  @param [out] time
+ *      Reference where store the time of the first wave.
+ *  @param [out] delta
+ *      Reference where store the time between two waves.
+ *  
+ *  @return true if the header is well formed, false otherwise.
+ */
+static bool protocol_readMultiHeader(uint32_t* time, uint16_t* delta);
+
 /**
  *	@todo doc
  */
@@ -97,7 +111,7 @@ static void protocol_addStart(uint8_t* buffer, uint16_t* pos);
  */
 static void protocol_addEnd(uint8_t* buffer, uint16_t* pos);
 
-char const protocol_frameId[cProtocolFrameNumber][PROTOCOL_FRAME_TYPE_SIZE + 1] = {"ACK", 
+char const protocol_frameId[cProtocolFrameNumber][PROTOCOL_FRAME_TYPE_SIZE + 1] PROGMEM = {"ACK", 
                                                                                    "YOP", 
                                                                                    "SYN",
                                                                                    "ERR", 
@@ -107,31 +121,84 @@ char const protocol_frameId[cProtocolFrameNumber][PROTOCOL_FRAME_TYPE_SIZE + 1]
                                                                                    "DC1", 
                                                                                    "DCN",
                                                                                    "DA1", 
-                                                                                   "DAN"
+                                                                                   "DAN",
+                                                                                   "BRE",
+                                                                                   "SPC",
+                                                                                   "EPO",
+                                                                                   "EVT",
+                                                                                   "CAL",
+                                                                                   "BDR",
+                                                                                   "SEQ",
+                                                                                   "NAK",
+                                                                                   "CFG",
+                                                                                   "STA",
+                                                                                   "DCH",
+                                                                                   "CHS"
                                                                                    /* ^-insert new frames id at the end-^ */
                                                                                    /* According to eProtocolFrame order.  */
                                                                                    };
 
+/**
+ *	Fails to compile when a type of frame needs more RAM than PROTOCOL_RAM_BUDGET.
+ *
+ *  @internal
+ *
+ *  @note The error names the type of frame, tProtocol_ramXXX.
+ */
+#define PROTOCOL_CHECK_RAM(type)    typedef char tProtocol_ram##type[((PROTOCOL_RAM_##type) <= (PROTOCOL_RAM_BUDGET)) ? 1 : -1]
+
+PROTOCOL_CHECK_RAM(ACK);
+PROTOCOL_CHECK_RAM(YOP);
+PROTOCOL_CHECK_RAM(SYN);
+PROTOCOL_CHECK_RAM(ERR);
+PROTOCOL_CHECK_RAM(BAT);
+PROTOCOL_CHECK_RAM(MOD);
+PROTOCOL_CHECK_RAM(DR1);
+PROTOCOL_CHECK_RAM(DC1);
+PROTOCOL_CHECK_RAM(DA1);
+PROTOCOL_CHECK_RAM(DCN);
+PROTOCOL_CHECK_RAM(DAN);
+PROTOCOL_CHECK_RAM(BRE);
+PROTOCOL_CHECK_RAM(SPC);
+PROTOCOL_CHECK_RAM(EPO);
+PROTOCOL_CHECK_RAM(EVT);
+PROTOCOL_CHECK_RAM(CAL);
+PROTOCOL_CHECK_RAM(BDR);
+PROTOCOL_CHECK_RAM(SEQ);
+PROTOCOL_CHECK_RAM(NAK);
+PROTOCOL_CHECK_RAM(CFG);
+PROTOCOL_CHECK_RAM(STA);
+PROTOCOL_CHECK_RAM(DCH);
+PROTOCOL_CHECK_RAM(CHS);
+
+/**
+ *	Fails to compile when the FSC's channels can't be packed by pairs in DCH frames.
+ *
+ *  @internal
+ */
+typedef char tProtocol_packedFSC[((PROTOCOL_FSC_NUMBER) % 2 == 0) ? 1 : -1];
+
 static uint16_t protocol_read16(void)
 {
     uint16_t value;
 
-    value  = protocol_read8() << 8;
-    value += protocol_read8();
+    /* Assembled most significant byte first : already in host order. */
+    value  = (uint16_t)((uint8_t)protocol_read8()) << 8;
+    value += (uint8_t)protocol_read8();
     
-    return endian_ntohs(value);
+    return value;
 }
 
 static uint32_t protocol_read32(void)
 {
     uint32_t value;
 
-    value  = ((uint32_t)protocol_read8()) << 24;
-    value += ((uint32_t)protocol_read8()) << 16;
-    value += ((uint32_t)protocol_read8()) << 8;
-    value += ((uint32_t)protocol_read8());
+    value  = ((uint32_t)(uint8_t)protocol_read8()) << 24;
+    value += ((uint32_t)(uint8_t)protocol_read8()) << 16;
+    value += ((uint32_t)(uint8_t)protocol_read8()) << 8;
+    value += ((uint32_t)(uint8_t)protocol_read8());
 
-    return endian_ntohl(value);
+    return value;
 }
 
 static void protocol_readFSC(uint16_t* fscValues)
@@ -154,6 +221,20 @@ static void protocol_readFSR(uint16_t* fsrValues)
         fsrValues[iterFsr] = protocol_read16();
 }
 
+static bool protocol_readMultiHeader(uint32_t* time, uint16_t* delta)
+{
+    /* <TIME>,<DELTA> */
+    assert(time != NULL);
+    assert(delta != NULL);
+
+    *time = protocol_read32();
+    if (!protocol_isSeparator())
+        return false;
+    *delta = protocol_read16();
+
+    return true;
+}
+
 static void protocol_addSep(uint8_t* buffer, uint16_t* pos)
 {
     buffer[*pos] = PROTOCOL_FRAME_SEP;
@@ -162,7 +243,7 @@ static void protocol_addSep(uint8_t* buffer, uint16_t* pos)
 
 static void protocol_addFrameId(uint8_t* buffer, uint16_t* pos, eProtocolFrame id)
 {
-    memcpy(buffer + *pos, protocol_frameId[id], PROTOCOL_FRAME_TYPE_SIZE);
+    progmem_memcpy(buffer + *pos, protocol_frameId[id], PROTOCOL_FRAME_TYPE_SIZE);
     *pos += PROTOCOL_FRAME_TYPE_SIZE;
 }
 
@@ -183,7 +264,7 @@ eProtocolFrame protocol_frameIdentification(char const buffer[PROTOCOL_FRAME_TYP
     assert(buffer != NULL);
 
     eProtocolFrame iterFrame = 0;
-    while (iterFrame < cProtocolFrameNumber && strncmp(buffer, protocol_frameId[iterFrame], PROTOCOL_FRAME_TYPE_SIZE) != 0)
+    while (iterFrame < cProtocolFrameNumber && progmem_strncmp(buffer, protocol_frameId[iterFrame], PROTOCOL_FRAME_TYPE_SIZE) != 0)
         iterFrame++;
         
     assert(iterFrame <= cProtocolFrameNumber);
@@ -194,6 +275,59 @@ eProtocolFrame protocol_frameIdentification(char const buffer[PROTOCOL_FRAME_TYP
     return iterFrame;
 }
 
+uint16_t protocol_getFrameSize(uint8_t const* buffer, const uint16_t size)
+{
+    uint16_t frameSize;
+    uint16_t varSize = 0;
+
+    assert(buffer != NULL);
+
+    if (size < PROTOCOL_FRAME_START_SIZE + PROTOCOL_FRAME_TYPE_SIZE || buffer[0] != PROTOCOL_FRAME_START)
+        return 0;
+
+    switch (protocol_frameIdentification((char const*)buffer + PROTOCOL_FRAME_START_SIZE))
+    {
+        case cProtocolFrameACK : frameSize = PROTOCOL_ACK_SIZE; break;
+        case cProtocolFrameYOP : frameSize = PROTOCOL_YOP_SIZE; break;
+        case cProtocolFrameSYN : frameSize = PROTOCOL_SYN_SIZE; break;
+        case cProtocolFrameERR : frameSize = PROTOCOL_ERR_SIZE; break;
+        case cProtocolFrameBAT : frameSize = PROTOCOL_BAT_SIZE; break;
+        case cProtocolFrameMOD : frameSize = PROTOCOL_MOD_SIZE; break;
+        case cProtocolFrameDR1 : frameSize = PROTOCOL_DR1_SIZE; break;
+        case cProtocolFrameDC1 : frameSize = PROTOCOL_DC1_SIZE; break;
+        case cProtocolFrameDA1 : frameSize = PROTOCOL_DA1_SIZE; break;
+        case cProtocolFrameBRE : frameSize = PROTOCOL_BRE_SIZE; break;
+        case cProtocolFrameSPC : frameSize = PROTOCOL_SPC_SIZE; break;
+        case cProtocolFrameEPO : frameSize = PROTOCOL_EPO_SIZE; break;
+        case cProtocolFrameEVT : frameSize = PROTOCOL_EVT_SIZE; break;
+        case cProtocolFrameCAL : frameSize = PROTOCOL_CAL_SIZE; break;
+        case cProtocolFrameBDR : frameSize = PROTOCOL_BDR_SIZE; break;
+        case cProtocolFrameSEQ : frameSize = PROTOCOL_SEQ_SIZE; break;
+        case cProtocolFrameNAK : frameSize = PROTOCOL_NAK_SIZE; break;
+        case cProtocolFrameCFG : frameSize = PROTOCOL_CFG_SIZE; break;
+        case cProtocolFrameSTA : frameSize = PROTOCOL_STA_SIZE; break;
+        case cProtocolFrameDCH : frameSize = PROTOCOL_DCH_SIZE; break;
+        case cProtocolFrameCHS : frameSize = PROTOCOL_CHS_SIZE; break;
+        case cProtocolFrameDCN :
+            frameSize = PROTOCOL_DCN_MIN_SIZE;
+            varSize = PROTOCOL_DCN_VAR_SIZE;
+            break;
+        case cProtocolFrameDAN :
+            frameSize = PROTOCOL_DAN_MIN_SIZE;
+            varSize = PROTOCOL_DAN_VAR_SIZE;
+            break;
+        default :
+            return 0;
+    }
+
+    /* Elements of fixed size : a separator instead of the end means one more element. */
+    if (varSize > 0)
+        while (frameSize <= size && buffer[frameSize - PROTOCOL_FRAME_END_SIZE] == PROTOCOL_FRAME_SEP)
+            frameSize += varSize;
+
+    return (frameSize <= size && buffer[frameSize - PROTOCOL_FRAME_END_SIZE] == PROTOCOL_FRAME_END) ? frameSize : 0;
+}
+
 bool protocol_parseYOP(uint8_t* fsrNumber, uint8_t* fscNumber)
 {
 	bool bOk;
@@ -258,8 +392,22 @@ uint16_t protocol_createYOP(tProtocol_bufferYOP buffer)
 	
 }
 
-uint16_t protocol_createACK(tProtocol_bufferACK buffer)
+bool protocol_parseACK(uint16_t* seq, uint16_t* mask)
+{
+	assert(seq != NULL);
+	assert(mask != NULL);
+
+	*seq = protocol_read16();
+	if (!protocol_isSeparator())
+		return false;
+	*mask = protocol_read16();
+
+	return protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createACK(const uint16_t seq, const uint16_t mask, tProtocol_bufferACK buffer)
 {
+	/* $ACK,<SEQ>,<MASK>\n */
 	uint16_t pos;
 
 	assert(buffer != NULL);
@@ -270,8 +418,17 @@ uint16_t protocol_createACK(tProtocol_bufferACK buffer)
 
 	protocol_addFrameId(buffer, &pos, cProtocolFrameACK);
 
-	buffer[pos] = PROTOCOL_FRAME_END;
-	pos += PROTOCOL_FRAME_END_SIZE;
+	protocol_addSep(buffer, &pos);
+
+	endian_copyToB(buffer + pos, &seq, PROTOCOL_FRAME_SEQ_SIZE, PROTOCOL_FRAME_SEQ_SIZE);
+	pos += PROTOCOL_FRAME_SEQ_SIZE;
+
+	protocol_addSep(buffer, &pos);
+
+	endian_copyToB(buffer + pos, &mask, PROTOCOL_FRAME_MASK_SIZE, PROTOCOL_FRAME_MASK_SIZE);
+	pos += PROTOCOL_FRAME_MASK_SIZE;
+
+	protocol_addEnd(buffer, &pos);
 
 	assert(pos == PROTOCOL_ACK_SIZE);
 
@@ -303,7 +460,7 @@ uint16_t protocol_createSYN(const uint32_t timeData, tProtocol_bufferSYN buffer)
 
     protocol_addSep(buffer, &pos);
 
-    memcpy(buffer + pos, &timeData, PROTOCOL_FRAME_TIME_SIZE);
+    endian_copyToB(buffer + pos, &timeData, PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
     pos += PROTOCOL_FRAME_TIME_SIZE;
 
     protocol_addEnd(buffer, &pos);
@@ -353,20 +510,56 @@ uint16_t protocol_createERR(const eProtocolError errNum, tProtocol_bufferERR buf
     return pos;
 }
 
-/** 
- *  @todo
- */
-bool protocol_parseBAT(void)
+bool protocol_parseBAT(struct sProtocolBAT* sBat)
 {
-    return true;
+    bool bOk = false;
+
+    assert(sBat != NULL);
+
+    sBat->time = protocol_read32();
+    if (protocol_isSeparator())
+    {
+        sBat->voltage = protocol_read16();
+        sBat->charge = protocol_read8();
+        bOk = (sBat->charge <= 100);
+    }
+
+    return bOk && protocol_isEndOfFrame();
 }
 
-/** 
- *  @todo
- */
-uint16_t protocol_createBAT(void)
+uint16_t protocol_createBAT(struct sProtocolBAT const* sBat, tProtocol_bufferBAT buffer)
 {
-    return 0;
+    /* $BAT,<TIME>,<VOLTAGE><CHARGE>\n */
+    uint16_t pos;
+
+    assert(sBat != NULL);
+    assert(sBat->charge <= 100);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameBAT);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sBat->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    pos += PROTOCOL_FRAME_TIME_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sBat->voltage), PROTOCOL_FRAME_VOLTAGE_SIZE, PROTOCOL_FRAME_VOLTAGE_SIZE);
+    pos += PROTOCOL_FRAME_VOLTAGE_SIZE;
+
+    buffer[pos] = sBat->charge;
+    pos += PROTOCOL_FRAME_CHARGE_SIZE;
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_BAT_SIZE);
+
+    return pos;
 }
 
 bool protocol_parseMOD(eProtocolMode* modeNum)
@@ -415,11 +608,17 @@ bool protocol_parseDR1(struct sProtocolDR1* sDr1)
 
     assert(sDr1 != NULL);
 
-    sDr1->time = protocol_read32();
+    /* The radio's identity, known from the packet's source. */
+    protocol_read32();
+    protocol_read32();
     if (protocol_isSeparator())
     {
-        protocol_readFSR(sDr1->fsrValues);
-        bOk = true;
+        sDr1->time = protocol_read32();
+        if (protocol_isSeparator())
+        {
+            protocol_readFSR(sDr1->fsrValues);
+            bOk = true;
+        }
     }
 
     return bOk && protocol_isEndOfFrame();
@@ -427,7 +626,7 @@ bool protocol_parseDR1(struct sProtocolDR1* sDr1)
 
 uint16_t protocol_createDR1(struct sProtocolDR1 const* sDr1, tProtocol_bufferDR1 buffer)
 {
-    /* $DR1,<TIME>,<R0><R1>...<RN>\n */
+    /* $DR1,<ID>,<TIME>,<R0><R1>...<RN>\n */
     uint16_t pos;
 
     assert(sDr1 != NULL);
@@ -448,10 +647,10 @@ uint16_t protocol_createDR1(struct sProtocolDR1 const* sDr1, tProtocol_bufferDR1
     
     protocol_addSep(buffer, &pos);
     
-    /*endian_copyToB(buffer + pos, &(sDr1->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    endian_copyToB(buffer + pos, &(sDr1->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
     pos += PROTOCOL_FRAME_TIME_SIZE;
 
-    protocol_addSep(buffer, &pos);*/
+    protocol_addSep(buffer, &pos);
     
     endian_copyToB(buffer + pos, sDr1->fsrValues, PROTOCOL_FRAME_FSR_SIZE * PROTOCOL_FSR_NUMBER, PROTOCOL_FRAME_FSR_SIZE);
     pos += PROTOCOL_FRAME_FSR_SIZE * PROTOCOL_FSR_NUMBER;
@@ -513,41 +712,25 @@ uint16_t protocol_createDC1(struct sProtocolDC1 const* sDc1, tProtocol_bufferDC1
 
 }
 
+#ifdef PROTOCOL_MULTI_CONTAINERS
 bool protocol_parseDCN(struct sProtocolDCN* sDcn)
 {
-    bool bOk = false;
-    uint16_t nbSamples;
-    char buf;
+    eProtocolWave wave;
 
     assert(sDcn != NULL);
 
-    sDcn->time = protocol_read32();
-    if (protocol_isSeparator())
-    {
-        sDcn->delta = protocol_read32();
-        if (protocol_isSeparator())
-        {
-            bOk = true;
-            nbSamples = 0;
-            do
-            {
-                /* At least one wave of sampling. */
-                protocol_readFSC(sDcn->fscValues[nbSamples]);
-                buf = protocol_readChar();
-                bOk = (buf == PROTOCOL_FRAME_SEP || buf == PROTOCOL_FRAME_END);
-            /* if there is a separator then parse an other wave. */
-            } while (   bOk &&
-                        buf == PROTOCOL_FRAME_SEP &&
-                        ++nbSamples <= PROTOCOL_DCN_SAMPLE_MAX);
-            /* Too much waves ? */
-            if (nbSamples > PROTOCOL_DCN_SAMPLE_MAX)
-                bOk = false;
-            else
-                sDcn->nbSamples = nbSamples;
-        }
-    }
-
-    return bOk && protocol_isEndOfFrame();
+    if (!protocol_beginDCN(&(sDcn->time), &(sDcn->delta)))
+        return false;
+    sDcn->nbSamples = 0;
+    /* At least one wave of sampling. */
+    do
+        wave = protocol_nextDCN(sDcn->fscValues[sDcn->nbSamples]);
+    while (wave == cProtocolWaveRead && ++sDcn->nbSamples < PROTOCOL_DCN_SAMPLE_MAX);
+    /* Too much waves ? */
+    if (wave == cProtocolWaveRead)
+        wave = protocol_isEndOfFrame() ? cProtocolWaveEnd : cProtocolWaveError;
+
+    return (wave == cProtocolWaveEnd && sDcn->nbSamples > 0);
 }
 
 uint16_t protocol_createDCN(struct sProtocolDCN const* sDcn, tProtocol_bufferDCN buffer)
@@ -573,8 +756,8 @@ uint16_t protocol_createDCN(struct sProtocolDCN const* sDcn, tProtocol_bufferDCN
 
     protocol_addSep(buffer, &pos);
 
-    endian_copyToB(buffer + pos, &(sDcn->delta), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
-    pos += PROTOCOL_FRAME_TIME_SIZE;
+    endian_copyToB(buffer + pos, &(sDcn->delta), PROTOCOL_FRAME_DELTA_SIZE, PROTOCOL_FRAME_DELTA_SIZE);
+    pos += PROTOCOL_FRAME_DELTA_SIZE;
 
     for (iterSamples = 0 ; iterSamples < sDcn->nbSamples ; iterSamples++)
     {
@@ -594,7 +777,30 @@ uint16_t protocol_createDCN(struct sProtocolDCN const* sDcn, tProtocol_bufferDCN
 
 }
 
-uint16_t protocol_initDCN(struct sProtocolDC1 const* sDc1, const uint32_t delta, uint8_t buffer[PROTOCOL_DCN_MIN_SIZE - PROTOCOL_FRAME_END])
+#endif
+
+bool protocol_beginDCN(uint32_t* time, uint16_t* delta)
+{
+    return protocol_readMultiHeader(time, delta);
+}
+
+eProtocolWave protocol_nextDCN(uint16_t fscValues[PROTOCOL_FSC_NUMBER])
+{
+    char buf;
+
+    assert(fscValues != NULL);
+
+    buf = protocol_readChar();
+    if (buf == PROTOCOL_FRAME_END)
+        return cProtocolWaveEnd;
+    if (buf != PROTOCOL_FRAME_SEP)
+        return cProtocolWaveError;
+    protocol_readFSC(fscValues);
+
+    return cProtocolWaveRead;
+}
+
+uint16_t protocol_initDCN(struct sProtocolDC1 const* sDc1, const uint16_t delta, uint8_t buffer[PROTOCOL_DCN_MIN_SIZE - PROTOCOL_FRAME_END_SIZE])
 {
     /* $DCN,<TIME>,<DELTA>,<C0><C1>...<CN> */
     uint16_t pos;
@@ -615,12 +821,12 @@ uint16_t protocol_initDCN(struct sProtocolDC1 const* sDc1, const uint32_t delta,
 
     protocol_addSep(buffer, &pos);
 
-    endian_copyToB(buffer + pos, &delta, PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
-    pos += PROTOCOL_FRAME_TIME_SIZE;
+    endian_copyToB(buffer + pos, &delta, PROTOCOL_FRAME_DELTA_SIZE, PROTOCOL_FRAME_DELTA_SIZE);
+    pos += PROTOCOL_FRAME_DELTA_SIZE;
 
     pos += protocol_extendDCN(sDc1->fscValues, buffer + pos);
 
-    assert(pos == PROTOCOL_DCN_MIN_SIZE - PROTOCOL_FRAME_END);
+    assert(pos == PROTOCOL_DCN_MIN_SIZE - PROTOCOL_FRAME_END_SIZE);
 
     return pos;
 }
@@ -644,7 +850,7 @@ uint16_t protocol_extendDCN(uint16_t const fscValues[PROTOCOL_FSC_NUMBER], uint8
     return pos;
 }
 
-inline uint16_t protocol_endDCN(uint8_t buffer[PROTOCOL_FRAME_END_SIZE])
+uint16_t protocol_endDCN(uint8_t buffer[PROTOCOL_FRAME_END_SIZE])
 {
     buffer[0] = PROTOCOL_FRAME_END;
     
@@ -709,47 +915,25 @@ uint16_t protocol_createDA1(struct sProtocolDA1 const* sDa1, tProtocol_bufferDA1
 
 }
 
+#ifdef PROTOCOL_MULTI_CONTAINERS
 bool protocol_parseDAN(struct sProtocolDAN* sDan)
 {
-    bool bOk = false;
-    uint16_t nbSamples;
-    char buf;
+    eProtocolWave wave;
 
     assert(sDan != NULL);
 
-    sDan->time = protocol_read32();
-    if (protocol_isSeparator())
-    {
-        sDan->delta = protocol_read32();
-        if (protocol_isSeparator())
-        {
-            bOk = true;
-            nbSamples = 0;
-            do
-            {
-                /* At least one wave of sampling. */
-                protocol_readFSR(sDan->fsrValues[nbSamples]);
-                bOk = protocol_isSeparator();
-                if (bOk)
-                {
-                    protocol_readFSC(sDan->fscValues[nbSamples]);
-                    buf = protocol_readChar();
-                    bOk = (buf == PROTOCOL_FRAME_SEP || buf == PROTOCOL_FRAME_END);
-                }
-            /* if there is a separator then parse an other wave. */
-            } while (   bOk &&
-                        buf == PROTOCOL_FRAME_SEP &&
-                        ++nbSamples < PROTOCOL_DAN_SAMPLE_MAX
-                    );
-            /* Too much waves ? */
-            if (nbSamples > PROTOCOL_DCN_SAMPLE_MAX)
-                bOk = false;
-            else
-                sDan->nbSamples = nbSamples;
-        }
-    }
-
-    return bOk && protocol_isEndOfFrame();
+    if (!protocol_beginDAN(&(sDan->time), &(sDan->delta)))
+        return false;
+    sDan->nbSamples = 0;
+    /* At least one wave of sampling. */
+    do
+        wave = protocol_nextDAN(sDan->fsrValues[sDan->nbSamples], sDan->fscValues[sDan->nbSamples]);
+    while (wave == cProtocolWaveRead && ++sDan->nbSamples < PROTOCOL_DAN_SAMPLE_MAX);
+    /* Too much waves ? */
+    if (wave == cProtocolWaveRead)
+        wave = protocol_isEndOfFrame() ? cProtocolWaveEnd : cProtocolWaveError;
+
+    return (wave == cProtocolWaveEnd && sDan->nbSamples > 0);
 }
 
 uint16_t protocol_createDAN(struct sProtocolDAN const* sDan, tProtocol_bufferDAN buffer)
@@ -775,8 +959,8 @@ uint16_t protocol_createDAN(struct sProtocolDAN const* sDan, tProtocol_bufferDAN
 
     protocol_addSep(buffer, &pos);
 
-    endian_copyToB(buffer + pos, &(sDan->delta), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
-    pos += PROTOCOL_FRAME_TIME_SIZE;
+    endian_copyToB(buffer + pos, &(sDan->delta), PROTOCOL_FRAME_DELTA_SIZE, PROTOCOL_FRAME_DELTA_SIZE);
+    pos += PROTOCOL_FRAME_DELTA_SIZE;
 
     for (iterSamples = 0 ; iterSamples < sDan->nbSamples ; iterSamples++)
     {
@@ -785,13 +969,40 @@ uint16_t protocol_createDAN(struct sProtocolDAN const* sDan, tProtocol_bufferDAN
 
     pos += protocol_endDAN(buffer + pos);
 
-    assert(pos >= PROTOCOL_DCN_MIN_SIZE);
+    assert(pos >= PROTOCOL_DAN_MIN_SIZE);
     assert(pos < PROTOCOL_DATA_SIZE_MAX);
 
     return pos;
 }
 
-uint16_t protocol_initDAN(struct sProtocolDA1 const* sDa1, const uint32_t delta, uint8_t buffer[PROTOCOL_DAN_MIN_SIZE - PROTOCOL_FRAME_END])
+#endif
+
+bool protocol_beginDAN(uint32_t* time, uint16_t* delta)
+{
+    return protocol_readMultiHeader(time, delta);
+}
+
+eProtocolWave protocol_nextDAN(uint16_t fsrValues[PROTOCOL_FSR_NUMBER], uint16_t fscValues[PROTOCOL_FSC_NUMBER])
+{
+    char buf;
+
+    assert(fsrValues != NULL);
+    assert(fscValues != NULL);
+
+    buf = protocol_readChar();
+    if (buf == PROTOCOL_FRAME_END)
+        return cProtocolWaveEnd;
+    if (buf != PROTOCOL_FRAME_SEP)
+        return cProtocolWaveError;
+    protocol_readFSR(fsrValues);
+    if (!protocol_isSeparator())
+        return cProtocolWaveError;
+    protocol_readFSC(fscValues);
+
+    return cProtocolWaveRead;
+}
+
+uint16_t protocol_initDAN(struct sProtocolDA1 const* sDa1, const uint16_t delta, uint8_t buffer[PROTOCOL_DAN_MIN_SIZE - PROTOCOL_FRAME_END_SIZE])
 {
     /* $DAN,<TIME>,<DELTA>,<C0><C1>...<CN> */
     uint16_t pos;
@@ -812,12 +1023,12 @@ uint16_t protocol_initDAN(struct sProtocolDA1 const* sDa1, const uint32_t delta,
 
     protocol_addSep(buffer, &pos);
 
-    endian_copyToB(buffer + pos, &delta, PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
-    pos += PROTOCOL_FRAME_TIME_SIZE;
+    endian_copyToB(buffer + pos, &delta, PROTOCOL_FRAME_DELTA_SIZE, PROTOCOL_FRAME_DELTA_SIZE);
+    pos += PROTOCOL_FRAME_DELTA_SIZE;
 
     pos += protocol_extendDAN(sDa1->fsrValues, sDa1->fscValues, buffer + pos);
 
-    assert(pos == PROTOCOL_DAN_MIN_SIZE - PROTOCOL_FRAME_END);
+    assert(pos == PROTOCOL_DAN_MIN_SIZE - PROTOCOL_FRAME_END_SIZE);
 
     return pos;
 }
@@ -847,9 +1058,724 @@ uint16_t protocol_extendDAN(uint16_t const fsrValues[PROTOCOL_FSR_NUMBER], uint1
     return pos;
 }
 
-inline uint16_t protocol_endDAN(uint8_t buffer[PROTOCOL_FRAME_END_SIZE])
+uint16_t protocol_endDAN(uint8_t buffer[PROTOCOL_FRAME_END_SIZE])
 {
     buffer[0] = PROTOCOL_FRAME_END;
     
     return PROTOCOL_FRAME_END_SIZE;
 }
+
+bool protocol_parseBRE(struct sProtocolBRE* sBre)
+{
+    bool bOk = false;
+
+    assert(sBre != NULL);
+
+    sBre->time = protocol_read32();
+    if (protocol_isSeparator())
+    {
+        sBre->rate       = protocol_read16();
+        sBre->amplitude  = protocol_read16();
+        sBre->confidence = protocol_read8();
+        bOk = true;
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createBRE(struct sProtocolBRE const* sBre, tProtocol_bufferBRE buffer)
+{
+    /* $BRE,<TIME>,<RATE><AMP><CONF>\n */
+    uint16_t pos;
+
+    assert(sBre != NULL);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameBRE);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sBre->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    pos += PROTOCOL_FRAME_TIME_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sBre->rate), PROTOCOL_FRAME_RATE_SIZE, PROTOCOL_FRAME_RATE_SIZE);
+    pos += PROTOCOL_FRAME_RATE_SIZE;
+
+    endian_copyToB(buffer + pos, &(sBre->amplitude), PROTOCOL_FRAME_AMP_SIZE, PROTOCOL_FRAME_AMP_SIZE);
+    pos += PROTOCOL_FRAME_AMP_SIZE;
+
+    buffer[pos] = sBre->confidence;
+    pos += PROTOCOL_FRAME_CONF_SIZE;
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_BRE_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseSPC(struct sProtocolSPC* sSpc)
+{
+    bool bOk = false;
+    uint8_t iterBin;
+
+    assert(sSpc != NULL);
+
+    sSpc->time = protocol_read32();
+    if (protocol_isSeparator())
+    {
+        sSpc->exponent = protocol_read8();
+        for (iterBin = 0 ; iterBin < PROTOCOL_SPC_BIN_NUMBER ; iterBin++)
+            sSpc->power[iterBin] = protocol_read16();
+        bOk = true;
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createSPC(struct sProtocolSPC const* sSpc, tProtocol_bufferSPC buffer)
+{
+    /* $SPC,<TIME>,<EXP><B0><B1>...<BN>\n */
+    uint16_t pos;
+
+    assert(sSpc != NULL);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameSPC);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sSpc->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    pos += PROTOCOL_FRAME_TIME_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    buffer[pos++] = sSpc->exponent;
+
+    endian_copyToB(buffer + pos, sSpc->power, PROTOCOL_FRAME_BIN_SIZE * PROTOCOL_SPC_BIN_NUMBER, PROTOCOL_FRAME_BIN_SIZE);
+    pos += PROTOCOL_FRAME_BIN_SIZE * PROTOCOL_SPC_BIN_NUMBER;
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_SPC_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseEPO(struct sProtocolEPO* sEpo)
+{
+    bool bOk = false;
+    uint8_t iterFsr;
+
+    assert(sEpo != NULL);
+
+    sEpo->time = protocol_read32();
+    if (protocol_isSeparator())
+    {
+        sEpo->nbSweeps  = protocol_read16();
+        sEpo->flags     = protocol_read8();
+        sEpo->occupancy = protocol_read8();
+        sEpo->copMean   = protocol_read16();
+        sEpo->copShift  = protocol_read16();
+        if (protocol_isSeparator())
+        {
+            for (iterFsr = 0 ; iterFsr < PROTOCOL_FSR_NUMBER ; iterFsr++)
+            {
+                sEpo->min[iterFsr]    = protocol_read16();
+                sEpo->max[iterFsr]    = protocol_read16();
+                sEpo->mean[iterFsr]   = protocol_read16();
+                sEpo->energy[iterFsr] = protocol_read16();
+            }
+            bOk = true;
+        }
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createEPO(struct sProtocolEPO const* sEpo, tProtocol_bufferEPO buffer)
+{
+    /* $EPO,<TIME>,<NB><FLAGS><OCC><COP><SHIFT>,<MIN0><MAX0><MEAN0><NRJ0>...<MINN><MAXN><MEANN><NRJN>\n */
+    uint16_t pos;
+    uint8_t iterFsr;
+
+    assert(sEpo != NULL);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameEPO);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sEpo->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    pos += PROTOCOL_FRAME_TIME_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sEpo->nbSweeps), sizeof(uint16_t), sizeof(uint16_t));
+    pos += sizeof(uint16_t);
+
+    buffer[pos++] = sEpo->flags;
+    buffer[pos++] = sEpo->occupancy;
+
+    endian_copyToB(buffer + pos, &(sEpo->copMean), sizeof(uint16_t), sizeof(uint16_t));
+    pos += sizeof(uint16_t);
+
+    endian_copyToB(buffer + pos, &(sEpo->copShift), sizeof(uint16_t), sizeof(uint16_t));
+    pos += sizeof(uint16_t);
+
+    protocol_addSep(buffer, &pos);
+
+    for (iterFsr = 0 ; iterFsr < PROTOCOL_FSR_NUMBER ; iterFsr++)
+    {
+        endian_copyToB(buffer + pos, &(sEpo->min[iterFsr]), sizeof(uint16_t), sizeof(uint16_t));
+        pos += sizeof(uint16_t);
+        endian_copyToB(buffer + pos, &(sEpo->max[iterFsr]), sizeof(uint16_t), sizeof(uint16_t));
+        pos += sizeof(uint16_t);
+        endian_copyToB(buffer + pos, &(sEpo->mean[iterFsr]), sizeof(uint16_t), sizeof(uint16_t));
+        pos += sizeof(uint16_t);
+        endian_copyToB(buffer + pos, &(sEpo->energy[iterFsr]), sizeof(uint16_t), sizeof(uint16_t));
+        pos += sizeof(uint16_t);
+    }
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_EPO_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseEVT(struct sProtocolEVT* sEvt)
+{
+    bool bOk = false;
+
+    assert(sEvt != NULL);
+
+    sEvt->time = protocol_read32();
+    if (protocol_isSeparator())
+    {
+        sEvt->event = protocol_read8();
+        sEvt->copX  = protocol_read16();
+        sEvt->copY  = protocol_read16();
+        sEvt->load  = protocol_read16();
+        bOk = (sEvt->event < cProtocolEventNumber);
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createEVT(struct sProtocolEVT const* sEvt, tProtocol_bufferEVT buffer)
+{
+    /* $EVT,<TIME>,<EVENT><X><Y><LOAD>\n */
+    uint16_t pos;
+
+    assert(sEvt != NULL);
+    assert(sEvt->event < cProtocolEventNumber);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameEVT);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sEvt->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    pos += PROTOCOL_FRAME_TIME_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    buffer[pos++] = sEvt->event;
+
+    endian_copyToB(buffer + pos, &(sEvt->copX), sizeof(int16_t), sizeof(int16_t));
+    pos += sizeof(int16_t);
+
+    endian_copyToB(buffer + pos, &(sEvt->copY), sizeof(int16_t), sizeof(int16_t));
+    pos += sizeof(int16_t);
+
+    endian_copyToB(buffer + pos, &(sEvt->load), sizeof(uint16_t), sizeof(uint16_t));
+    pos += sizeof(uint16_t);
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_EVT_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseCAL(struct sProtocolCAL* sCal)
+{
+    bool bOk = false;
+    uint8_t iterPoint;
+
+    assert(sCal != NULL);
+
+    sCal->channel = protocol_read8();
+    if (sCal->channel < PROTOCOL_FSR_NUMBER + PROTOCOL_FSC_NUMBER && protocol_isSeparator())
+    {
+        for (iterPoint = 0 ; iterPoint < PROTOCOL_CAL_POINT_NUMBER ; iterPoint++)
+            sCal->points[iterPoint] = protocol_read16();
+        bOk = true;
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createCAL(struct sProtocolCAL const* sCal, tProtocol_bufferCAL buffer)
+{
+    /* $CAL,<CHANNEL>,<P0><P1>...<PN>\n */
+    uint16_t pos;
+
+    assert(sCal != NULL);
+    assert(sCal->channel < PROTOCOL_FSR_NUMBER + PROTOCOL_FSC_NUMBER);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameCAL);
+
+    protocol_addSep(buffer, &pos);
+
+    buffer[pos++] = sCal->channel;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, sCal->points, sizeof(uint16_t) * PROTOCOL_CAL_POINT_NUMBER, sizeof(uint16_t));
+    pos += sizeof(uint16_t) * PROTOCOL_CAL_POINT_NUMBER;
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_CAL_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseBDR(uint32_t* rate)
+{
+    assert(rate != NULL);
+
+    *rate = protocol_read32();
+
+    return protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createBDR(const uint32_t rate, tProtocol_bufferBDR buffer)
+{
+    /* $BDR,<RATE>\n */
+    uint16_t pos;
+
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameBDR);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &rate, sizeof(uint32_t), sizeof(uint32_t));
+    pos += sizeof(uint32_t);
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_BDR_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseSEQ(uint16_t* seq)
+{
+    assert(seq != NULL);
+
+    *seq = protocol_read16();
+
+    return protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createSEQ(const uint16_t seq, tProtocol_bufferSEQ buffer)
+{
+    /* $SEQ,<SEQ>\n */
+    uint16_t pos;
+
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameSEQ);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &seq, PROTOCOL_FRAME_SEQ_SIZE, PROTOCOL_FRAME_SEQ_SIZE);
+    pos += PROTOCOL_FRAME_SEQ_SIZE;
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_SEQ_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseNAK(uint16_t* first, uint16_t* last)
+{
+    assert(first != NULL);
+    assert(last != NULL);
+
+    *first = protocol_read16();
+    if (!protocol_isSeparator())
+        return false;
+    *last = protocol_read16();
+
+    return protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createNAK(const uint16_t first, const uint16_t last, tProtocol_bufferNAK buffer)
+{
+    /* $NAK,<FIRST>,<LAST>\n */
+    uint16_t pos;
+
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameNAK);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &first, PROTOCOL_FRAME_SEQ_SIZE, PROTOCOL_FRAME_SEQ_SIZE);
+    pos += PROTOCOL_FRAME_SEQ_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &last, PROTOCOL_FRAME_SEQ_SIZE, PROTOCOL_FRAME_SEQ_SIZE);
+    pos += PROTOCOL_FRAME_SEQ_SIZE;
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_NAK_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseCFG(eProtocolConfig* key, uint32_t* value)
+{
+    bool bOk = false;
+
+    assert(key != NULL);
+    assert(value != NULL);
+
+    *key = (uint8_t)protocol_read8();
+    if (*key < cProtocolConfigNumber && protocol_isSeparator())
+    {
+        *value = protocol_read32();
+        bOk = true;
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createCFG(const eProtocolConfig key, const uint32_t value, tProtocol_bufferCFG buffer)
+{
+    /* $CFG,<KEY>,<VALUE>\n */
+    uint16_t pos;
+
+    assert(key < cProtocolConfigNumber);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameCFG);
+
+    protocol_addSep(buffer, &pos);
+
+    buffer[pos] = key;
+    pos += PROTOCOL_FRAME_KEY_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &value, PROTOCOL_FRAME_VALUE_SIZE, PROTOCOL_FRAME_VALUE_SIZE);
+    pos += PROTOCOL_FRAME_VALUE_SIZE;
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_CFG_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseSTA(struct sProtocolSTA* sSta)
+{
+    bool bOk = false;
+    uint8_t iter;
+    uint8_t iterBucket;
+
+    assert(sSta != NULL);
+
+    sSta->time = protocol_read32();
+    if (protocol_isSeparator())
+    {
+        sSta->stackFree = protocol_read16();
+        sSta->busDelay = protocol_read16();
+        for (iter = 0 ; iter < PROTOCOL_STA_COUNTER_NUMBER ; iter++)
+            sSta->counters[iter] = protocol_read16();
+        if (protocol_isSeparator())
+        {
+            for (iter = 0 ; iter < PROTOCOL_STA_PROBE_NUMBER ; iter++)
+            {
+                sSta->probes[iter].count = protocol_read16();
+                sSta->probes[iter].min   = protocol_read32();
+                sSta->probes[iter].max   = protocol_read32();
+                for (iterBucket = 0 ; iterBucket < PROTOCOL_STA_BUCKET_NUMBER ; iterBucket++)
+                    sSta->probes[iter].share[iterBucket] = protocol_read8();
+            }
+            bOk = true;
+        }
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createSTA(struct sProtocolSTA const* sSta, tProtocol_bufferSTA buffer)
+{
+    /* $STA,<TIME>,<FREE><BUS><N0>...<NN>,<COUNT0><MIN0><MAX0><H00>...<H0N>...<COUNTN><MINN><MAXN><HN0>...<HNN>\n */
+    uint16_t pos;
+    uint8_t iter;
+
+    assert(sSta != NULL);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameSTA);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sSta->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    pos += PROTOCOL_FRAME_TIME_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sSta->stackFree), sizeof(uint16_t), sizeof(uint16_t));
+    pos += sizeof(uint16_t);
+
+    endian_copyToB(buffer + pos, &(sSta->busDelay), sizeof(uint16_t), sizeof(uint16_t));
+    pos += sizeof(uint16_t);
+
+    endian_copyToB(buffer + pos, sSta->counters, sizeof(uint16_t) * PROTOCOL_STA_COUNTER_NUMBER, sizeof(uint16_t));
+    pos += sizeof(uint16_t) * PROTOCOL_STA_COUNTER_NUMBER;
+
+    protocol_addSep(buffer, &pos);
+
+    for (iter = 0 ; iter < PROTOCOL_STA_PROBE_NUMBER ; iter++)
+    {
+        endian_copyToB(buffer + pos, &(sSta->probes[iter].count), sizeof(uint16_t), sizeof(uint16_t));
+        pos += sizeof(uint16_t);
+        endian_copyToB(buffer + pos, &(sSta->probes[iter].min), sizeof(uint32_t), sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+        endian_copyToB(buffer + pos, &(sSta->probes[iter].max), sizeof(uint32_t), sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+        memcpy(buffer + pos, sSta->probes[iter].share, PROTOCOL_STA_BUCKET_NUMBER);
+        pos += PROTOCOL_STA_BUCKET_NUMBER;
+    }
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_STA_SIZE);
+
+    return pos;
+}
+
+bool protocol_parseDCH(struct sProtocolDCH* sDch)
+{
+    bool bOk = false;
+    uint8_t iterWave;
+    uint8_t iter;
+    uint8_t packed[3];
+
+    assert(sDch != NULL);
+
+    sDch->time = protocol_read32();
+    if (protocol_isSeparator())
+    {
+        sDch->delta = protocol_read16();
+        if (protocol_isSeparator())
+        {
+            for (iterWave = 0 ; iterWave < PROTOCOL_DCH_WAVE_NUMBER ; iterWave++)
+                for (iter = 0 ; iter < PROTOCOL_FSC_NUMBER ; iter += 2)
+                {
+                    packed[0] = protocol_read8();
+                    packed[1] = protocol_read8();
+                    packed[2] = protocol_read8();
+                    sDch->fscValues[iterWave][iter]     = ((uint16_t)packed[0] << 4) | (packed[1] >> 4);
+                    sDch->fscValues[iterWave][iter + 1] = ((uint16_t)(packed[1] & 0x0F) << 8) | packed[2];
+                }
+            bOk = true;
+        }
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createDCH(struct sProtocolDCH const* sDch, tProtocol_bufferDCH buffer)
+{
+    /* $DCH,<TIME>,<DELTA>,<P0>...<PN>\n */
+    uint16_t pos;
+    uint8_t iterWave;
+
+    assert(sDch != NULL);
+    assert(buffer != NULL);
+
+    pos = protocol_initDCH(sDch->time, sDch->delta, buffer);
+
+    for (iterWave = 0 ; iterWave < PROTOCOL_DCH_WAVE_NUMBER ; iterWave++)
+        pos += protocol_extendDCH(sDch->fscValues[iterWave], buffer + pos);
+
+    pos += protocol_endDCH(buffer + pos);
+
+    assert(pos == PROTOCOL_DCH_SIZE);
+
+    return pos;
+}
+
+uint16_t protocol_initDCH(const uint32_t time, const uint16_t delta, uint8_t buffer[PROTOCOL_DCH_SIZE - PROTOCOL_FRAME_END_SIZE - PROTOCOL_FRAME_PACKED_SIZE * PROTOCOL_DCH_WAVE_NUMBER])
+{
+    /* $DCH,<TIME>,<DELTA>, */
+    uint16_t pos;
+
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameDCH);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &time, PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    pos += PROTOCOL_FRAME_TIME_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &delta, PROTOCOL_FRAME_DELTA_SIZE, PROTOCOL_FRAME_DELTA_SIZE);
+    pos += PROTOCOL_FRAME_DELTA_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    assert(pos == PROTOCOL_DCH_SIZE - PROTOCOL_FRAME_END_SIZE - PROTOCOL_FRAME_PACKED_SIZE * PROTOCOL_DCH_WAVE_NUMBER);
+
+    return pos;
+}
+
+uint16_t protocol_extendDCH(uint16_t const fscValues[PROTOCOL_FSC_NUMBER], uint8_t buffer[PROTOCOL_FRAME_PACKED_SIZE])
+{
+    /* <AAAAAAAA><AAAABBBB><BBBBBBBB> for each pair of channels. */
+    uint16_t pos;
+    uint16_t first;
+    uint16_t second;
+    uint8_t iter;
+
+    assert(fscValues != NULL);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    for (iter = 0 ; iter < PROTOCOL_FSC_NUMBER ; iter += 2)
+    {
+        first  = (fscValues[iter] > 0x0FFF) ? 0x0FFF : fscValues[iter];
+        second = (fscValues[iter + 1] > 0x0FFF) ? 0x0FFF : fscValues[iter + 1];
+        buffer[pos++] = (uint8_t)(first >> 4);
+        buffer[pos++] = (uint8_t)((first << 4) | (second >> 8));
+        buffer[pos++] = (uint8_t)second;
+    }
+
+    assert(pos == PROTOCOL_FRAME_PACKED_SIZE);
+
+    return pos;
+}
+
+uint16_t protocol_endDCH(uint8_t buffer[PROTOCOL_FRAME_END_SIZE])
+{
+    buffer[0] = PROTOCOL_FRAME_END;
+
+    return PROTOCOL_FRAME_END_SIZE;
+}
+
+bool protocol_parseCHS(struct sProtocolCHS* sChs)
+{
+    bool bOk = false;
+
+    assert(sChs != NULL);
+
+    sChs->time = protocol_read32();
+    if (protocol_isSeparator())
+    {
+        sChs->stuck = protocol_read16();
+        sChs->saturated = protocol_read16();
+        sChs->disconnected = protocol_read16();
+        bOk = true;
+    }
+
+    return bOk && protocol_isEndOfFrame();
+}
+
+uint16_t protocol_createCHS(struct sProtocolCHS const* sChs, tProtocol_bufferCHS buffer)
+{
+    /* $CHS,<TIME>,<STUCK><SATURATED><DISCONNECTED>\n */
+    uint16_t pos;
+
+    assert(sChs != NULL);
+    assert(buffer != NULL);
+
+    pos = 0;
+
+    protocol_addStart(buffer, &pos);
+
+    protocol_addFrameId(buffer, &pos, cProtocolFrameCHS);
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sChs->time), PROTOCOL_FRAME_TIME_SIZE, PROTOCOL_FRAME_TIME_SIZE);
+    pos += PROTOCOL_FRAME_TIME_SIZE;
+
+    protocol_addSep(buffer, &pos);
+
+    endian_copyToB(buffer + pos, &(sChs->stuck), PROTOCOL_FRAME_MASK_SIZE, PROTOCOL_FRAME_MASK_SIZE);
+    pos += PROTOCOL_FRAME_MASK_SIZE;
+
+    endian_copyToB(buffer + pos, &(sChs->saturated), PROTOCOL_FRAME_MASK_SIZE, PROTOCOL_FRAME_MASK_SIZE);
+    pos += PROTOCOL_FRAME_MASK_SIZE;
+
+    endian_copyToB(buffer + pos, &(sChs->disconnected), PROTOCOL_FRAME_MASK_SIZE, PROTOCOL_FRAME_MASK_SIZE);
+    pos += PROTOCOL_FRAME_MASK_SIZE;
+
+    protocol_addEnd(buffer, &pos);
+
+    assert(pos == PROTOCOL_CHS_SIZE);
+
+    return pos;
+}
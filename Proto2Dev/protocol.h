@@ -26,6 +26,7 @@
  #endif
  
  #include "endian.h"
+ #include "progmem.h"
 
   /**
    *    Leading character of frames.
@@ -59,6 +60,10 @@
    *    Size of a time argument in frames.
    */
  #define PROTOCOL_FRAME_TIME_SIZE   sizeof(uint32_t)
+  /**
+   *    Size of a time between consecutive samples in frames.
+   */
+ #define PROTOCOL_FRAME_DELTA_SIZE  sizeof(uint16_t)
   /**
    *    Size of an error argument in frames.
    */
@@ -87,11 +92,19 @@
    *    Size of an FSC sensor's data in frames.
    */
  #define PROTOCOL_FRAME_FSC_SIZE    sizeof(uint16_t)
+  /**
+   *    Size of the selective acknowledgment mask in frames.
+   */
+ #define PROTOCOL_FRAME_MASK_SIZE   sizeof(uint16_t)
   /**
    *    Size of an ACK frame.
    */
  #define PROTOCOL_ACK_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
                                         (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_SEQ_SIZE)                           + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_MASK_SIZE)                          + \
                                         (PROTOCOL_FRAME_END_SIZE)                             \
                                     )
   /**
@@ -123,6 +136,26 @@
                                         (PROTOCOL_FRAME_ERR_SIZE)                           + \
                                         (PROTOCOL_FRAME_END_SIZE)                             \
                                     )
+  /**
+   *	Size of a voltage argument in frames.
+   */
+ #define PROTOCOL_FRAME_VOLTAGE_SIZE    sizeof(uint16_t)
+  /**
+   *	Size of a battery's charge argument in frames.
+   */
+ #define PROTOCOL_FRAME_CHARGE_SIZE sizeof(uint8_t)
+  /**
+   *	Size of a BAT frame.
+   */
+ #define PROTOCOL_BAT_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_VOLTAGE_SIZE)                       + \
+                                        (PROTOCOL_FRAME_CHARGE_SIZE)                        + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
   /**
    *	Size of an MOD frame.
    */
@@ -140,11 +173,11 @@
                                         (PROTOCOL_FRAME_SEP_SIZE)                           + \
                                         (sizeof(uint64_t))                                  + \
                                         (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
                                         (PROTOCOL_FRAME_FSR_SIZE) * (PROTOCOL_FSR_NUMBER)   + \
                                         (PROTOCOL_FRAME_END_SIZE)                             \
                                     )
-                                    /*(PROTOCOL_FRAME_TIME_SIZE)                          + \
-                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \*/
   /**
    *	Size of a DC1 frame.
    */
@@ -183,7 +216,7 @@
                                         (PROTOCOL_FRAME_SEP_SIZE)                           + \
                                         (PROTOCOL_FRAME_TIME_SIZE)                          + \
                                         (PROTOCOL_FRAME_SEP_SIZE)                           + \
-                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_DELTA_SIZE)                         + \
                                         (PROTOCOL_DCN_VAR_SIZE)                             + \
                                         (PROTOCOL_FRAME_END_SIZE)                             \
                                     )
@@ -203,10 +236,232 @@
                                         (PROTOCOL_FRAME_SEP_SIZE)                           + \
                                         (PROTOCOL_FRAME_TIME_SIZE)                          + \
                                         (PROTOCOL_FRAME_SEP_SIZE)                           + \
-                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_DELTA_SIZE)                         + \
                                         (PROTOCOL_DAN_VAR_SIZE)                             + \
                                         (PROTOCOL_FRAME_END_SIZE)                             \
                                     )
+  /**
+   *    Size of a wave of FSC's data packed on 12 bits in DCH frames.
+   */
+ #define PROTOCOL_FRAME_PACKED_SIZE ((PROTOCOL_FRAME_FSC_SIZE) * (PROTOCOL_FSC_NUMBER) * 3 / 4)
+  /**
+   *    Number of waves of a DCH frame.
+   *
+   *  @note A DCH frame fits in a radio packet after its SEQ frame.
+   */
+ #define PROTOCOL_DCH_WAVE_NUMBER   26
+  /**
+   *    Size of a DCH frame.
+   */
+ #define PROTOCOL_DCH_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_DELTA_SIZE)                         + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_PACKED_SIZE) * (PROTOCOL_DCH_WAVE_NUMBER) + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Size of a breathing rate argument in frames.
+   */
+ #define PROTOCOL_FRAME_RATE_SIZE   sizeof(uint16_t)
+  /**
+   *    Size of a breathing amplitude argument in frames.
+   */
+ #define PROTOCOL_FRAME_AMP_SIZE    sizeof(uint16_t)
+  /**
+   *    Size of a confidence argument in frames.
+   */
+ #define PROTOCOL_FRAME_CONF_SIZE   sizeof(uint8_t)
+  /**
+   *    Size of a BRE frame.
+   */
+ #define PROTOCOL_BRE_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_RATE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_AMP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_CONF_SIZE)                          + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Number of frequency bins in a SPC frame.
+   */
+ #define PROTOCOL_SPC_BIN_NUMBER    12
+  /**
+   *    Size of a bin's power in frames.
+   */
+ #define PROTOCOL_FRAME_BIN_SIZE    sizeof(uint16_t)
+  /**
+   *    Size of a SPC frame.
+   */
+ #define PROTOCOL_SPC_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        sizeof(uint8_t)                                     + \
+                                        (PROTOCOL_FRAME_BIN_SIZE) * (PROTOCOL_SPC_BIN_NUMBER) + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Size of the per channel statistics of an FSR in EPO frames (min, max, mean, energy).
+   */
+ #define PROTOCOL_FRAME_FSR_STAT_SIZE   (sizeof(uint16_t) * 4)
+  /**
+   *    Size of an EPO frame.
+   */
+ #define PROTOCOL_EPO_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        sizeof(uint16_t)                                    + \
+                                        sizeof(uint8_t)                                     + \
+                                        sizeof(uint8_t)                                     + \
+                                        sizeof(uint16_t)                                    + \
+                                        sizeof(uint16_t)                                    + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_FSR_STAT_SIZE) * (PROTOCOL_FSR_NUMBER) + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Size of an EVT frame.
+   */
+ #define PROTOCOL_EVT_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        sizeof(uint8_t)                                     + \
+                                        sizeof(int16_t)                                     + \
+                                        sizeof(int16_t)                                     + \
+                                        sizeof(uint16_t)                                    + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Number of points of a channel's calibration curve.
+   *
+   *    @note Points are equally spaced over [0;ADS7828_RESOLUTION].
+   */
+ #define PROTOCOL_CAL_POINT_NUMBER  5
+  /**
+   *    Size of a CAL frame.
+   */
+ #define PROTOCOL_CAL_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        sizeof(uint8_t)                                     + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        sizeof(uint16_t) * (PROTOCOL_CAL_POINT_NUMBER)      + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Size of a BDR frame.
+   */
+ #define PROTOCOL_BDR_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        sizeof(uint32_t)                                    + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Size of a sequence number argument in frames.
+   */
+ #define PROTOCOL_FRAME_SEQ_SIZE    sizeof(uint16_t)
+  /**
+   *    Size of a SEQ frame.
+   */
+ #define PROTOCOL_SEQ_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_SEQ_SIZE)                           + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Size of a NAK frame.
+   */
+ #define PROTOCOL_NAK_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_SEQ_SIZE)                           + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_SEQ_SIZE)                           + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Size of a configuration parameter's key in frames.
+   */
+ #define PROTOCOL_FRAME_KEY_SIZE    sizeof(uint8_t)
+  /**
+   *    Size of a configuration parameter's value in frames.
+   */
+ #define PROTOCOL_FRAME_VALUE_SIZE  sizeof(uint32_t)
+  /**
+   *    Size of a CFG frame.
+   */
+ #define PROTOCOL_CFG_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_KEY_SIZE)                           + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_VALUE_SIZE)                         + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Number of health counters in STA frames.
+   */
+ #define PROTOCOL_STA_COUNTER_NUMBER    4
+  /**
+   *    Number of timed sections in STA frames.
+   */
+ #define PROTOCOL_STA_PROBE_NUMBER  4
+  /**
+   *    Number of buckets of a timed section's histogram in STA frames.
+   *
+   *  @note A STA frame fits in a radio packet after its SEQ frame.
+   */
+ #define PROTOCOL_STA_BUCKET_NUMBER 7
+  /**
+   *    Size of a timed section's statistics in STA frames (count, min, max, histogram).
+   */
+ #define PROTOCOL_FRAME_PROBE_SIZE  (   sizeof(uint16_t)                                    + \
+                                        sizeof(uint32_t)                                    + \
+                                        sizeof(uint32_t)                                    + \
+                                        sizeof(uint8_t) * (PROTOCOL_STA_BUCKET_NUMBER)        \
+                                    )
+  /**
+   *    Size of a STA frame.
+   */
+ #define PROTOCOL_STA_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        sizeof(uint16_t)                                    + \
+                                        sizeof(uint16_t)                                    + \
+                                        sizeof(uint16_t) * (PROTOCOL_STA_COUNTER_NUMBER)    + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_PROBE_SIZE) * (PROTOCOL_STA_PROBE_NUMBER) + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
+  /**
+   *    Size of a CHS frame.
+   */
+ #define PROTOCOL_CHS_SIZE          (   (PROTOCOL_FRAME_START_SIZE)                         + \
+                                        (PROTOCOL_FRAME_TYPE_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_TIME_SIZE)                          + \
+                                        (PROTOCOL_FRAME_SEP_SIZE)                           + \
+                                        (PROTOCOL_FRAME_MASK_SIZE)                          + \
+                                        (PROTOCOL_FRAME_MASK_SIZE)                          + \
+                                        (PROTOCOL_FRAME_MASK_SIZE)                          + \
+                                        (PROTOCOL_FRAME_END_SIZE)                             \
+                                    )
   /**
    *	Maximum size of a frame in this protocol.
    */
@@ -219,6 +474,53 @@
    *	Maximum number of samples in a DAN frame.
    */
  #define PROTOCOL_DAN_SAMPLE_MAX    (((PROTOCOL_DATA_SIZE_MAX) - (PROTOCOL_DAN_MIN_SIZE)) / (PROTOCOL_DAN_VAR_SIZE) + 1)
+  /**
+   *	Defined when the containers of whole DCN and DAN frames are available.
+   *
+   *  They hold up to PROTOCOL_DATA_SIZE_MAX bytes of samples, far more than
+   *  the ATmega328's SRAM : the device streams these frames one wave at a
+   *  time with protocol_initDCN() and protocol_beginDCN() instead.
+   */
+ #if !defined(__AVR__) && !defined(PROTOCOL_MULTI_CONTAINERS)
+  #define PROTOCOL_MULTI_CONTAINERS
+ #endif
+  /**
+   *	Greatest RAM a frame may need to be built or read in bytes.
+   *
+   *  @note Checked at compile time against the PROTOCOL_RAM_XXX below.
+   */
+ #ifndef PROTOCOL_RAM_BUDGET
+  #define PROTOCOL_RAM_BUDGET       128
+ #endif
+  /**
+   *	RAM needed to build or read each type of frame in bytes.
+   *
+   *  A fixed size frame is held whole, a DCN or DAN frame only needs its
+   *  header and a single wave whatever its number of waves.
+   */
+ #define PROTOCOL_RAM_ACK           (PROTOCOL_ACK_SIZE)
+ #define PROTOCOL_RAM_YOP           (PROTOCOL_YOP_SIZE)
+ #define PROTOCOL_RAM_SYN           (PROTOCOL_SYN_SIZE)
+ #define PROTOCOL_RAM_ERR           (PROTOCOL_ERR_SIZE)
+ #define PROTOCOL_RAM_BAT           (PROTOCOL_BAT_SIZE)
+ #define PROTOCOL_RAM_MOD           (PROTOCOL_MOD_SIZE)
+ #define PROTOCOL_RAM_DR1           (PROTOCOL_DR1_SIZE)
+ #define PROTOCOL_RAM_DC1           (PROTOCOL_DC1_SIZE)
+ #define PROTOCOL_RAM_DA1           (PROTOCOL_DA1_SIZE)
+ #define PROTOCOL_RAM_DCN           (PROTOCOL_DCN_MIN_SIZE)
+ #define PROTOCOL_RAM_DAN           (PROTOCOL_DAN_MIN_SIZE)
+ #define PROTOCOL_RAM_BRE           (PROTOCOL_BRE_SIZE)
+ #define PROTOCOL_RAM_SPC           (PROTOCOL_SPC_SIZE)
+ #define PROTOCOL_RAM_EPO           (PROTOCOL_EPO_SIZE)
+ #define PROTOCOL_RAM_EVT           (PROTOCOL_EVT_SIZE)
+ #define PROTOCOL_RAM_CAL           (PROTOCOL_CAL_SIZE)
+ #define PROTOCOL_RAM_BDR           (PROTOCOL_BDR_SIZE)
+ #define PROTOCOL_RAM_SEQ           (PROTOCOL_SEQ_SIZE)
+ #define PROTOCOL_RAM_NAK           (PROTOCOL_NAK_SIZE)
+ #define PROTOCOL_RAM_CFG           (PROTOCOL_CFG_SIZE)
+ #define PROTOCOL_RAM_STA           (PROTOCOL_STA_SIZE)
+ #define PROTOCOL_RAM_DCH           (PROTOCOL_DCH_SIZE)
+ #define PROTOCOL_RAM_CHS           (PROTOCOL_CHS_SIZE)
 
  /**
   *	Enumeration of all frame's type.
@@ -227,17 +529,29 @@
   */
  typedef enum
  {
-    cProtocolFrameACK = 0,  /**< ACK : Frame for acknowledgment. */
+    cProtocolFrameACK = 0,  /**< ACK : Frame use by platform to acknowledge the frames received. */
     cProtocolFrameYOP,      /**< YOP : Frame send by a bed sensor at startup in order to be identified by a platform. */
     cProtocolFrameSYN,      /**< SYN : Frame for time synchronization between a bed sensor and a platform. */
     cProtocolFrameERR,      /**< ERR : Frame to report a error. */
-    cProtocolFrameBAT,      /**< BAT : Frame to inform platform about bed sensor's level of battery */
+    cProtocolFrameBAT,      /**< BAT : Frame to inform platform about bed sensor's level of battery. */
     cProtocolFrameMOD,      /**< MOD : Frame use by platform to order bed sensor to fall in a specific runtime mode. */
     cProtocolFrameDR1,      /**< DR1 : Frame for FSR's data sample encapsulation. */
     cProtocolFrameDC1,      /**< DC1 : Frame for one FSC's data sample encapsulation. */
     cProtocolFrameDCN,      /**< DCN : Frame for multiple FSC's data samples encapsulation. */
     cProtocolFrameDA1,      /**< DA1 : Frame for one FSR's data sample and one FSC's data sample encapsulation. */
     cProtocolFrameDAN,      /**< DAN : Frame for multiple FSR's data samples and FSC's data samples  (nbFSR = nbFSC) encapsulation. */
+    cProtocolFrameBRE,      /**< BRE : Frame for a breathing summary computed by the bed sensor. */
+    cProtocolFrameSPC,      /**< SPC : Frame for breathing band's spectral features computed by the bed sensor. */
+    cProtocolFrameEPO,      /**< EPO : Frame for an epoch's movement and occupancy summary computed by the bed sensor. */
+    cProtocolFrameEVT,      /**< EVT : Frame for an urgent event detected by the bed sensor. */
+    cProtocolFrameCAL,      /**< CAL : Frame use by platform to install a channel's calibration curve. */
+    cProtocolFrameBDR,      /**< BDR : Frame for the negotiation of the serial link's baud rate. */
+    cProtocolFrameSEQ,      /**< SEQ : Frame starting a radio packet with the sequence number of its next frame. */
+    cProtocolFrameNAK,      /**< NAK : Frame use by platform to request a range of lost frames. */
+    cProtocolFrameCFG,      /**< CFG : Frame use by platform to set a configuration parameter of the bed sensor. */
+    cProtocolFrameSTA,      /**< STA : Frame to report the bed sensor's timings and health counters. */
+    cProtocolFrameDCH,      /**< DCH : Frame for a window of FSC's data sampled at a high rate, packed on 12 bits. */
+    cProtocolFrameCHS,      /**< CHS : Frame to report the FSR's channels found stuck, saturated or disconnected. */
     /* ^-insert new frames at the end-^ */
     /*--------END OF ENUMERATION--------*/
     cProtocolFrameNumber,   /**< Number of frame's type. */
@@ -258,6 +572,28 @@
     cProtocolModeUnknow     /**< Value for an unknown runtime modes. */
  } eProtocolMode;
 
+ /**
+  *	Enumeration of bed sensor's configuration parameters.
+  */
+ typedef enum
+ {
+    cProtocolConfigDefaults = 0,    /**< Any value restores every parameters and forgets the radio's identity. */
+    cProtocolConfigSleepTime,       /**< Duration of a watch for a person in ms. */
+    cProtocolConfigSleepPeriod,     /**< Period of the FSR's sweeps while watching in ms. */
+    cProtocolConfigSleepDelta,      /**< Change of an FSR revealing an activity [1;4095]. */
+    cProtocolConfigMonitorTime,     /**< Maximum duration of a monitoring in ms. */
+    cProtocolConfigFsrPeriod,       /**< Period of the FSR's sweeps while monitoring in ms. */
+    cProtocolConfigFscPeriod,       /**< Period of the FSC's waves while monitoring in ms, less than the FSR's one. */
+    cProtocolConfigFsrMask,         /**< FSR's channels in use, bit i for channel i. */
+    cProtocolConfigFscMask,         /**< FSC's channels in use, bit i for channel i. */
+    cProtocolConfigOptions,         /**< Encoding options of the monitorings. */
+    cProtocolConfigHfcPeriod,       /**< Period of the FSC's waves of the accurate monitorings in us, 0 for the FSC's period. */
+    /* ^-insert new parameter at the end-^ */
+    /*-----------END OF ENUMERATION-----------*/
+    cProtocolConfigNumber,          /**< Number of parameters. */
+    cProtocolConfigUnknow           /**< Value for an unknown parameter. */
+ } eProtocolConfig;
+
  /**
   *	Enumeration of type of protocol errors.
   * @todo
@@ -283,7 +619,7 @@
   */
  struct sProtocolDR1
  {
-    uint32_t time;                              /**< Time of acquisition from millis(). */
+    uint32_t time;                              /**< Time of acquisition on the platform's clock in ms. */
     uint16_t fsrValues[PROTOCOL_FSR_NUMBER];    /**< FSR's data samples. */
  };
 
@@ -292,7 +628,7 @@
   */
  struct sProtocolDA1
  {
-    uint32_t time;                              /**< Time of acquisition from millis(). */
+    uint32_t time;                              /**< Time of acquisition on the platform's clock in ms. */
     uint16_t fsrValues[PROTOCOL_FSR_NUMBER];    /**< FSR's data samples. */
     uint16_t fscValues[PROTOCOL_FSC_NUMBER];    /**< FSC's data samples. */
  };
@@ -302,41 +638,209 @@
   */
  struct sProtocolDC1
  {
-    uint32_t time;                              /**< Time of acquistion from millis(). */
+    uint32_t time;                              /**< Time of acquistion on the platform's clock in ms. */
     uint16_t fscValues[PROTOCOL_FSC_NUMBER];    /**< FSC's data samples. */
  };
  
+ #ifdef PROTOCOL_MULTI_CONTAINERS
  /**
   *	Container for DCN frame data.
   */
  struct sProtocolDCN
  {
-    uint32_t time;                                                      /**< Time of the first acquisition from millis(). */
-    uint32_t delta;                                                     /**< Time between both consecutive sampling waves. */
+    uint32_t time;                                                      /**< Time of the first acquisition on the platform's clock in ms. */
+    uint16_t delta;                                                     /**< Time between both consecutive sampling waves in ms. */
     uint16_t fscValues[PROTOCOL_DCN_SAMPLE_MAX][PROTOCOL_FSC_NUMBER];   /**< FSC's data from sampling waves sort by time of acquisition. */
     uint16_t nbSamples;                                                 /**< Number of sampling waves in the frame. */
  };
 
  struct sProtocolDAN
  {
-    uint32_t time;                                                      /**< Time of the first acquisition from millis(). */
-    uint32_t delta;                                                     /**< Time between both consecutive sampling waves. */
+    uint32_t time;                                                      /**< Time of the first acquisition on the platform's clock in ms. */
+    uint16_t delta;                                                     /**< Time between both consecutive sampling waves in ms. */
     uint16_t fscValues[PROTOCOL_DAN_SAMPLE_MAX][PROTOCOL_FSC_NUMBER];   /**< FSR's data from sampling waves sort by time of acquisition. */
     uint16_t fsrValues[PROTOCOL_DAN_SAMPLE_MAX][PROTOCOL_FSR_NUMBER];   /**< FSC's data from sampling waves sort by time of acquisition. */
     uint16_t nbSamples;                                                 /**< Number of sampling waves in the frame. */
  };
+ #endif
+
+ /**
+  *	Result of the reading of a wave in a DCN or DAN frame.
+  */
+ typedef enum
+ {
+    cProtocolWaveRead = 0,  /**< A wave has been read, others may follow. */
+    cProtocolWaveEnd,       /**< The frame ended properly, no wave read. */
+    cProtocolWaveError      /**< The frame is broken. */
+ } eProtocolWave;
+
+ /**
+  *	Container for BRE frame data.
+  */
+ struct sProtocolBRE
+ {
+    uint32_t time;                              /**< Time of the end of the analysis window on the platform's clock in ms. */
+    uint16_t rate;                              /**< Breathing rate in tenth of breaths per minute, 0 if unknown. */
+    uint16_t amplitude;                         /**< Peak to peak amplitude of the filtered breathing signal. */
+    uint8_t  confidence;                        /**< Regularity of the breathing cycles [0;255]. */
+ };
+
+ /**
+  *	Container for SPC frame data.
+  *
+  *  Bin's power is given by power[i] << exponent.
+  */
+ struct sProtocolSPC
+ {
+    uint32_t time;                              /**< Time of the end of the analysis block on the platform's clock in ms. */
+    uint8_t  exponent;                          /**< Shift shared by all the bins. */
+    uint16_t power[PROTOCOL_SPC_BIN_NUMBER];    /**< Power of each frequency bin, lowest frequency first. */
+ };
+
+ /**
+  *	Occupancy flags of an EPO frame.
+  */
+ typedef enum
+ {
+    cProtocolOccupancyAny  = 0x01,  /**< The bed was occupied during at least one sweep. */
+    cProtocolOccupancyAll  = 0x02,  /**< The bed was occupied during every sweeps. */
+    cProtocolOccupancyLast = 0x04   /**< The bed was occupied during the last sweep. */
+ } eProtocolOccupancy;
+
+ /**
+  *	Container for EPO frame data.
+  */
+ struct sProtocolEPO
+ {
+    uint32_t time;                              /**< Time of the start of the epoch on the platform's clock in ms. */
+    uint16_t nbSweeps;                          /**< Number of FSR's sweeps in the epoch. */
+    uint8_t  flags;                             /**< Occupancy flags, combination of eProtocolOccupancy. */
+    uint8_t  occupancy;                         /**< Ratio of occupied sweeps [0;255]. */
+    uint16_t copMean;                           /**< Mean center of pressure along the bed in mm. */
+    uint16_t copShift;                          /**< Range covered by the center of pressure along the bed in mm. */
+    uint16_t min[PROTOCOL_FSR_NUMBER];          /**< Minimum of each FSR. */
+    uint16_t max[PROTOCOL_FSR_NUMBER];          /**< Maximum of each FSR. */
+    uint16_t mean[PROTOCOL_FSR_NUMBER];         /**< Mean of each FSR. */
+    uint16_t energy[PROTOCOL_FSR_NUMBER];       /**< Mean square difference between consecutive sweeps of each FSR. */
+ };
+
+ /**
+  *	Enumeration of events reported by EVT frames.
+  */
+ typedef enum
+ {
+    cProtocolEventExit = 0, /**< The person left the bed. */
+    cProtocolEventEntry,    /**< A person lay on the bed. */
+    /* ^-insert new event at the end-^ */
+    /*--------END OF ENUMERATION-------*/
+    cProtocolEventNumber,   /**< Number of type of events. */
+    cProtocolEventUnknow    /**< Value for an unknown type of events. */
+ } eProtocolEvent;
+
+ /**
+  *	Container for EVT frame data.
+  */
+ struct sProtocolEVT
+ {
+    uint32_t time;                              /**< Time of detection on the platform's clock in ms. */
+    uint8_t  event;                             /**< Type of event, value of eProtocolEvent. */
+    int16_t  copX;                              /**< Center of pressure across the bed in mm. */
+    int16_t  copY;                              /**< Center of pressure along the bed in mm. */
+    uint16_t load;                              /**< Total load of the FSR's. */
+ };
+
+ /**
+  *	Container for BAT frame data.
+  */
+ struct sProtocolBAT
+ {
+    uint32_t time;                              /**< Time of the measurement on the platform's clock in ms. */
+    uint16_t voltage;                           /**< Filtered supply voltage in mV. */
+    uint8_t  charge;                            /**< Remaining charge [0;100] %. */
+ };
+
+ /**
+  *	Container for CAL frame data.
+  */
+ struct sProtocolCAL
+ {
+    uint8_t  channel;                               /**< FSR's channels first, then FSC's channels. */
+    uint16_t points[PROTOCOL_CAL_POINT_NUMBER];     /**< Calibrated values at equally spaced raw values. */
+ };
+
+ /**
+  *	Statistics of a timed section in STA frames.
+  *
+  *  Bucket i of the histogram holds the durations in [2^(4+2i);2^(6+2i)[ us,
+  *  the first one those below 64 us and the last one those above 262 ms.
+  */
+ struct sProtocolProbe
+ {
+    uint16_t count;                                 /**< Number of runs of the section. */
+    uint32_t min;                                   /**< Shortest run in us. */
+    uint32_t max;                                   /**< Longest run in us. */
+    uint8_t  share[PROTOCOL_STA_BUCKET_NUMBER];     /**< Ratio of the runs in each bucket [0;255]. */
+ };
+
+ /**
+  *	Container for STA frame data.
+  */
+ struct sProtocolSTA
+ {
+    uint32_t time;                                              /**< Time of the end of the period on the platform's clock in ms. */
+    uint16_t stackFree;                                         /**< SRAM never reached by the stack since startup in bytes, UINT16_MAX if unknown. */
+    uint16_t busDelay;                                          /**< Longest delay of an ADC's sweep by the memory on the I2C bus over the period in ms. */
+    uint16_t counters[PROTOCOL_STA_COUNTER_NUMBER];             /**< Health counters over the period. */
+    struct sProtocolProbe probes[PROTOCOL_STA_PROBE_NUMBER];    /**< Timed sections over the period. */
+ };
+
+ /**
+  *	Container for DCH frame data.
+  */
+ struct sProtocolDCH
+ {
+    uint32_t time;                                                      /**< Time of the first wave on the platform's clock in ms. */
+    uint16_t delta;                                                     /**< Time between both consecutive waves in us. */
+    uint16_t fscValues[PROTOCOL_DCH_WAVE_NUMBER][PROTOCOL_FSC_NUMBER];  /**< FSC's data of the waves sort by time of acquisition, [0;4095]. */
+ };
+
+ /**
+  *	Container for CHS frame data.
+  */
+ struct sProtocolCHS
+ {
+    uint32_t time;                              /**< Time of the end of the period on the platform's clock in ms. */
+    uint16_t stuck;                             /**< FSR's channels stuck over the period, bit i for channel i. */
+    uint16_t saturated;                         /**< FSR's channels saturated over the period, bit i for channel i. */
+    uint16_t disconnected;                      /**< FSR's channels disconnected over the period, bit i for channel i. */
+ };
 
  /* @todo documentation */
  typedef uint8_t tProtocol_bufferACK [PROTOCOL_ACK_SIZE];
  typedef uint8_t tProtocol_bufferYOP [PROTOCOL_YOP_SIZE];
  typedef uint8_t tProtocol_bufferSYN [PROTOCOL_SYN_SIZE];
  typedef uint8_t tProtocol_bufferERR [PROTOCOL_ERR_SIZE];
+ typedef uint8_t tProtocol_bufferBAT [PROTOCOL_BAT_SIZE];
  typedef uint8_t tProtocol_bufferMOD [PROTOCOL_MOD_SIZE];
  typedef uint8_t tProtocol_bufferDR1 [PROTOCOL_DR1_SIZE];
  typedef uint8_t tProtocol_bufferDC1 [PROTOCOL_DC1_SIZE];
  typedef uint8_t tProtocol_bufferDA1 [PROTOCOL_DA1_SIZE];
+ #ifdef PROTOCOL_MULTI_CONTAINERS
  typedef uint8_t tProtocol_bufferDCN [PROTOCOL_DATA_SIZE_MAX];
  typedef uint8_t tProtocol_bufferDAN [PROTOCOL_DATA_SIZE_MAX];
+ #endif
+ typedef uint8_t tProtocol_bufferBRE [PROTOCOL_BRE_SIZE];
+ typedef uint8_t tProtocol_bufferSPC [PROTOCOL_SPC_SIZE];
+ typedef uint8_t tProtocol_bufferEPO [PROTOCOL_EPO_SIZE];
+ typedef uint8_t tProtocol_bufferEVT [PROTOCOL_EVT_SIZE];
+ typedef uint8_t tProtocol_bufferCAL [PROTOCOL_CAL_SIZE];
+ typedef uint8_t tProtocol_bufferBDR [PROTOCOL_BDR_SIZE];
+ typedef uint8_t tProtocol_bufferSEQ [PROTOCOL_SEQ_SIZE];
+ typedef uint8_t tProtocol_bufferNAK [PROTOCOL_NAK_SIZE];
+ typedef uint8_t tProtocol_bufferCFG [PROTOCOL_CFG_SIZE];
+ typedef uint8_t tProtocol_bufferSTA [PROTOCOL_STA_SIZE];
+ typedef uint8_t tProtocol_bufferDCH [PROTOCOL_DCH_SIZE];
+ typedef uint8_t tProtocol_bufferCHS [PROTOCOL_CHS_SIZE];
  
 /**
  *	Waiting to find a start of frame delimiter.
@@ -363,11 +867,11 @@
  
  extern uint32_t id1, id2;
  /**
-  *	Table of frame identifier.
+  *	Table of frame identifier, in program memory.
   * 
   * @see cProtocolFrame
   */
- extern char const protocol_frameId[cProtocolFrameNumber][PROTOCOL_FRAME_TYPE_SIZE + 1];
+ extern char const protocol_frameId[cProtocolFrameNumber][PROTOCOL_FRAME_TYPE_SIZE + 1] PROGMEM;
 /**
  *	Reference of the function for reading communication stream.
  *  
@@ -394,17 +898,35 @@
   */
   eProtocolFrame protocol_frameIdentification(char const buffer[PROTOCOL_FRAME_TYPE_SIZE]);
  
+ /**
+  * Computes the size of the first frame in a buffer of created frames.
+  *	
+  *	@param [in] buffer
+  *     Buffer starting with a frame.
+  * @param [in] size
+  *     Size of buffer.
+  *	
+  *	@return The size of the frame hopefully, 0 if the frame is unknown or incomplete.
+  */
+  uint16_t protocol_getFrameSize(uint8_t const* buffer, const uint16_t size);
+ 
  //////////////////////////////////////////////////////////////////////////
  // Frame Parsing
  
  /**
   *	Tries to parse argument of an ACK frame.
+  *	
+  *	@param [out] seq
+  *     Reference for storing the sequence number of the first frame not received,
+  *     all the previous ones being received.
+  *	@param [out] mask
+  *     Reference for storing the frames received after it, bit i for frame seq + 1 + i.
   *  
   *  @return true if the parsing succeeded, false otherwise.
   *  
   *  @see protocol_createACK()
   */
- #define protocol_parseACK() protocol_isEndOfFrame()
+ bool protocol_parseACK(uint16_t* seq, uint16_t* mask);
 
  /**
   *	Tries to parse a YOP frame.
@@ -444,6 +966,18 @@
   */
  bool protocol_parseERR(eProtocolError* errNum);
  
+ /**
+  *	Tries to parse a BAT frame.
+  *	
+  *	@param [out] sBat
+  *     Reference to the container for storing data from the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createBAT()
+  */
+ bool protocol_parseBAT(struct sProtocolBAT* sBat);
+ 
  /**
   *	Tries to parse a MOD frame.
   *	
@@ -480,6 +1014,7 @@
   */
  bool protocol_parseDC1(struct sProtocolDC1* sDc1);
  
+ #ifdef PROTOCOL_MULTI_CONTAINERS
  /**
   *	Tries to parse a DCN frame.
   *	
@@ -491,30 +1026,235 @@
   * @see protocol_createDCN()
   */
  bool protocol_parseDCN(struct sProtocolDCN* sDcn);
+ #endif
  
  /**
-  *	Tries to parse a DA1 frame.
+  *	Starts reading a DCN frame, its waves being read by protocol_nextDCN().
   *	
-  *	@param [out] sDa1
-  *     Reference for storing data of the frame.
+  *	@param [out] time
+  *     Reference for storing the time of the first wave.
+  *	@param [out] delta
+  *     Reference for storing the time between two waves.
   *
   * @return true if the parsing succeeded, false otherwise.
   *
-  * @see protocol_createDA1()
+  * @see protocol_initDCN()
   */
- bool protocol_parseDA1(struct sProtocolDA1* sDa1);
+ bool protocol_beginDCN(uint32_t* time, uint16_t* delta);
  
  /**
-  *	Tries to parse a DAN frame.
+  *	Reads the next wave of a DCN frame.
   *	
-  *	@param [out] sDan
-  *     Reference for storing data of the frame.
+  *	@param [out] fscValues
+  *     Reference for storing the FSC's data of the wave.
   *
-  * @return true if the parsing succeeded, false otherwise.
+  * @return cProtocolWaveRead while waves are read, then cProtocolWaveEnd at the end of the frame.
+  *
+  * @see protocol_extendDCN()
+  */
+ eProtocolWave protocol_nextDCN(uint16_t fscValues[PROTOCOL_FSC_NUMBER]);
+ 
+ /**
+  *	Tries to parse a DA1 frame.
+  *	
+  *	@param [out] sDa1
+  *     Reference for storing data of the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createDA1()
+  */
+ bool protocol_parseDA1(struct sProtocolDA1* sDa1);
+ 
+ #ifdef PROTOCOL_MULTI_CONTAINERS
+ /**
+  *	Tries to parse a DAN frame.
+  *	
+  *	@param [out] sDan
+  *     Reference for storing data of the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
   *
   * @see protocol_createDAN()
   */
  bool protocol_parseDAN(struct sProtocolDAN* sDan);
+ #endif
+ 
+ /**
+  *	Starts reading a DAN frame, its waves being read by protocol_nextDAN().
+  *	
+  *	@param [out] time
+  *     Reference for storing the time of the first wave.
+  *	@param [out] delta
+  *     Reference for storing the time between two waves.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_initDAN()
+  */
+ bool protocol_beginDAN(uint32_t* time, uint16_t* delta);
+ 
+ /**
+  *	Reads the next wave of a DAN frame.
+  *	
+  *	@param [out] fsrValues
+  *     Reference for storing the FSR's data of the wave.
+  *	@param [out] fscValues
+  *     Reference for storing the FSC's data of the wave.
+  *
+  * @return cProtocolWaveRead while waves are read, then cProtocolWaveEnd at the end of the frame.
+  *
+  * @see protocol_extendDAN()
+  */
+ eProtocolWave protocol_nextDAN(uint16_t fsrValues[PROTOCOL_FSR_NUMBER], uint16_t fscValues[PROTOCOL_FSC_NUMBER]);
+ 
+ /**
+  *	Tries to parse a BRE frame.
+  *	
+  *	@param [out] sBre
+  *     Reference for storing data of the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createBRE()
+  */
+ bool protocol_parseBRE(struct sProtocolBRE* sBre);
+ 
+ /**
+  *	Tries to parse a SPC frame.
+  *	
+  *	@param [out] sSpc
+  *     Reference for storing data of the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createSPC()
+  */
+ bool protocol_parseSPC(struct sProtocolSPC* sSpc);
+ 
+ /**
+  *	Tries to parse an EPO frame.
+  *	
+  *	@param [out] sEpo
+  *     Reference for storing data of the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createEPO()
+  */
+ bool protocol_parseEPO(struct sProtocolEPO* sEpo);
+ 
+ /**
+  *	Tries to parse an EVT frame.
+  *	
+  *	@param [out] sEvt
+  *     Reference for storing data of the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createEVT()
+  */
+ bool protocol_parseEVT(struct sProtocolEVT* sEvt);
+ 
+ /**
+  *	Tries to parse a CAL frame.
+  *	
+  *	@param [out] sCal
+  *     Reference for storing data of the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createCAL()
+  */
+ bool protocol_parseCAL(struct sProtocolCAL* sCal);
+ 
+ /**
+  *	Tries to parse a BDR frame.
+  *	
+  *	@param [out] rate
+  *     Reference for storing the baud rate in bps.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createBDR()
+  */
+ bool protocol_parseBDR(uint32_t* rate);
+ 
+ /**
+  *	Tries to parse a SEQ frame.
+  *	
+  *	@param [out] seq
+  *     Reference for storing the sequence number.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createSEQ()
+  */
+ bool protocol_parseSEQ(uint16_t* seq);
+ 
+ /**
+  *	Tries to parse a NAK frame.
+  *	
+  *	@param [out] first
+  *     Reference for storing the sequence number of the first lost frame.
+  *	@param [out] last
+  *     Reference for storing the sequence number of the last lost frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createNAK()
+  */
+ bool protocol_parseNAK(uint16_t* first, uint16_t* last);
+
+ /**
+  *	Tries to parse a CFG frame.
+  *	
+  *	@param [out] key
+  *     Reference for storing the parameter.
+  *	@param [out] value
+  *     Reference for storing the value of the parameter.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createCFG()
+  */
+ bool protocol_parseCFG(eProtocolConfig* key, uint32_t* value);
+
+ /**
+  *	Tries to parse a STA frame.
+  *	
+  *	@param [out] sSta
+  *     Reference to the container for storing data from the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createSTA()
+  */
+ bool protocol_parseSTA(struct sProtocolSTA* sSta);
+
+ /**
+  *	Tries to parse a DCH frame.
+  *	
+  *	@param [out] sDch
+  *     Reference to the container for storing data from the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createDCH()
+  */
+ bool protocol_parseDCH(struct sProtocolDCH* sDch);
+
+ /**
+  *	Tries to parse a CHS frame.
+  *	
+  *	@param [out] sChs
+  *     Reference to the container for storing data from the frame.
+  *
+  * @return true if the parsing succeeded, false otherwise.
+  *
+  * @see protocol_createCHS()
+  */
+ bool protocol_parseCHS(struct sProtocolCHS* sChs);
  
  //////////////////////////////////////////////////////////////////////////
  // Frame Creation
@@ -522,6 +1262,10 @@
  /**
   *	Create an ACK frame.
   * 
+  * @param [in] seq
+  *     Sequence number of the first frame not received.
+  * @param [in] mask
+  *     Frames received after it, bit i for frame seq + 1 + i.
   * @param [out] buffer
   *     Reference where store the computed frame.
   * 
@@ -529,7 +1273,7 @@
   *
   * @see protocol_parseACK()
   */
- uint16_t protocol_createACK(tProtocol_bufferACK buffer);
+ uint16_t protocol_createACK(const uint16_t seq, const uint16_t mask, tProtocol_bufferACK buffer);
  
  /**
   *	Create a YOP frame.
@@ -552,8 +1296,7 @@
   * @return The length of the frame.
   *
   * @see protocol_parseSYN()
-  * 
-  * @todo Change to direct use of millis ?
+  * @see clock_request()
   */
  uint16_t protocol_createSYN(const uint32_t timeData, tProtocol_bufferSYN buffer);
  
@@ -571,6 +1314,21 @@
   */
  uint16_t protocol_createERR(const eProtocolError errNum, tProtocol_bufferERR buffer);
  
+ /**
+  *	Create a BAT frame.
+  * 
+  * @param [in]  sBat
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseBAT()
+  * @see battery_getReport()
+  */
+ uint16_t protocol_createBAT(struct sProtocolBAT const* sBat, tProtocol_bufferBAT buffer);
+ 
  /**
   *	Create an MOD frame.
   * 
@@ -644,7 +1402,9 @@
   * @see protocol_extendDCN()
   * @see protocol_endDCN()
   */
+ #ifdef PROTOCOL_MULTI_CONTAINERS
  uint16_t protocol_createDCN(struct sProtocolDCN const* sDcn, tProtocol_bufferDCN buffer);
+ #endif
  
  /**
   *	Initializes a DCN frame.
@@ -659,7 +1419,7 @@
   * @param [in]  sDc1
   *     Reference to the container where find data to put in the frame.
   * @param [in] delta
-  *     Time between two waves of sampling.
+  *     Time between two waves of sampling in ms.
   * @param [out] buffer
   *     Reference to the current end of the frame.
   * 
@@ -669,7 +1429,7 @@
   * @see protocol_extendDCN()
   * @see protocol_endDCN()
   */
- uint16_t protocol_initDCN(struct sProtocolDC1 const* sDc1, const uint32_t delta, uint8_t buffer[PROTOCOL_DCN_MIN_SIZE - PROTOCOL_FRAME_END]);
+ uint16_t protocol_initDCN(struct sProtocolDC1 const* sDc1, const uint16_t delta, uint8_t buffer[PROTOCOL_DCN_MIN_SIZE - PROTOCOL_FRAME_END_SIZE]);
  
  /**
   *	Extends a DCN frame.
@@ -727,7 +1487,9 @@
   * @see protocol_extendDAN()
   * @see protocol_endDAN()
   */
+ #ifdef PROTOCOL_MULTI_CONTAINERS
  uint16_t protocol_createDAN(struct sProtocolDAN const* sDan, tProtocol_bufferDAN buffer);
+ #endif
  
  /**
   *	Initializes a DAN frame.
@@ -742,7 +1504,7 @@
   * @param [in]  sDa1
   *     Reference to the container where find data to put in the frame.
   * @param [in] delta
-  *     Time between two waves of sampling.
+  *     Time between two waves of sampling in ms.
   * @param [out] buffer
   *     Reference to the current end of the frame.
   * 
@@ -752,7 +1514,7 @@
   * @see protocol_extendDAN()
   * @see protocol_endDAN()
   */
- uint16_t protocol_initDAN(struct sProtocolDA1 const* sDa1, const uint32_t delta, uint8_t buffer[PROTOCOL_DAN_MIN_SIZE - PROTOCOL_FRAME_END]);
+ uint16_t protocol_initDAN(struct sProtocolDA1 const* sDa1, const uint16_t delta, uint8_t buffer[PROTOCOL_DAN_MIN_SIZE - PROTOCOL_FRAME_END_SIZE]);
  
  /**
   *	Extends a DAN frame.
@@ -793,7 +1555,262 @@
   * @see protocol_initDAN()
   * @see protocol_extendDAN()
   */
- inline uint16_t protocol_endDAN(uint8_t buffer[PROTOCOL_FRAME_END_SIZE]);
+ uint16_t protocol_endDAN(uint8_t buffer[PROTOCOL_FRAME_END_SIZE]);
+
+ // BRE
+ 
+ /**
+  *	Create a BRE frame.
+  * 
+  * @param [in]  sBre
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseBRE()
+  */
+ uint16_t protocol_createBRE(struct sProtocolBRE const* sBre, tProtocol_bufferBRE buffer);
+
+ // SPC
+ 
+ /**
+  *	Create a SPC frame.
+  * 
+  * @param [in]  sSpc
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseSPC()
+  */
+ uint16_t protocol_createSPC(struct sProtocolSPC const* sSpc, tProtocol_bufferSPC buffer);
+
+ // EPO
+ 
+ /**
+  *	Create an EPO frame.
+  * 
+  * @param [in]  sEpo
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseEPO()
+  */
+ uint16_t protocol_createEPO(struct sProtocolEPO const* sEpo, tProtocol_bufferEPO buffer);
+
+ // EVT
+ 
+ /**
+  *	Create an EVT frame.
+  * 
+  * @param [in]  sEvt
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseEVT()
+  */
+ uint16_t protocol_createEVT(struct sProtocolEVT const* sEvt, tProtocol_bufferEVT buffer);
+
+ // CAL
+ 
+ /**
+  *	Create a CAL frame.
+  * 
+  * @param [in]  sCal
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseCAL()
+  */
+ uint16_t protocol_createCAL(struct sProtocolCAL const* sCal, tProtocol_bufferCAL buffer);
+
+ // BDR
+ 
+ /**
+  *	Create a BDR frame.
+  * 
+  * The bed sensor sends its highest baud rate after the YOP frame,
+  * the platform answers with the baud rate it accepts and the bed sensor
+  * confirms with the baud rate really in use.
+  * 
+  * @param [in]  rate
+  *     Baud rate in bps.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseBDR()
+  */
+ uint16_t protocol_createBDR(const uint32_t rate, tProtocol_bufferBDR buffer);
+
+ // SEQ
+ 
+ /**
+  *	Create a SEQ frame.
+  * 
+  * Each radio packet starts with a SEQ frame, the following frames of
+  * the packet are numbered from seq, so the platform detects lost frames.
+  * 
+  * @param [in]  seq
+  *     Sequence number of the next frame, modulo 2^16.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseSEQ()
+  */
+ uint16_t protocol_createSEQ(const uint16_t seq, tProtocol_bufferSEQ buffer);
+
+ // NAK
+ 
+ /**
+  *	Create a NAK frame.
+  * 
+  * @param [in]  first
+  *     Sequence number of the first lost frame.
+  * @param [in]  last
+  *     Sequence number of the last lost frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseNAK()
+  */
+ uint16_t protocol_createNAK(const uint16_t first, const uint16_t last, tProtocol_bufferNAK buffer);
+
+ // CFG
+ 
+ /**
+  *	Create a CFG frame.
+  * 
+  * The bed sensor answers a CFG frame of the platform with the value
+  * really in use, so a rejected value is noticed.
+  * 
+  * @param [in]  key
+  *     The parameter.
+  * @param [in]  value
+  *     Value of the parameter.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseCFG()
+  */
+ uint16_t protocol_createCFG(const eProtocolConfig key, const uint32_t value, tProtocol_bufferCFG buffer);
+
+ // STA
+ 
+ /**
+  *	Create a STA frame.
+  * 
+  * @param [in]  sSta
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseSTA()
+  */
+ uint16_t protocol_createSTA(struct sProtocolSTA const* sSta, tProtocol_bufferSTA buffer);
+
+ // DCH
+ 
+ /**
+  *	Create a DCH frame.
+  * 
+  * @param [in]  sDch
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseDCH()
+  * @see protocol_initDCH()
+  */
+ uint16_t protocol_createDCH(struct sProtocolDCH const* sDch, tProtocol_bufferDCH buffer);
+
+ /**
+  *	Initializes a DCH frame, its waves following one at a time.
+  * 
+  * @warning Exactly PROTOCOL_DCH_WAVE_NUMBER calls to protocol_extendDCH()
+  *     then a call to protocol_endDCH() must follow.
+  *
+  * @param [in] time
+  *     Time of the first wave on the platform's clock in ms.
+  * @param [in] delta
+  *     Time between both consecutive waves in us.
+  * @param [out] buffer
+  *     Reference where store the start of the frame.
+  * 
+  * @return The length of the start of the frame.
+  *
+  * @see protocol_createDCH()
+  * @see protocol_extendDCH()
+  * @see protocol_endDCH()
+  */
+ uint16_t protocol_initDCH(const uint32_t time, const uint16_t delta, uint8_t buffer[PROTOCOL_DCH_SIZE - PROTOCOL_FRAME_END_SIZE - PROTOCOL_FRAME_PACKED_SIZE * PROTOCOL_DCH_WAVE_NUMBER]);
+
+ /**
+  *	Extends a DCH frame with a wave, each value saturated to 12 bits.
+  * 
+  * @param [in] fscValues
+  *     FSC's data of the wave.
+  * @param [out] buffer
+  *     Reference where store the wave.
+  * 
+  * @return The length of the wave.
+  *
+  * @see protocol_initDCH()
+  */
+ uint16_t protocol_extendDCH(uint16_t const fscValues[PROTOCOL_FSC_NUMBER], uint8_t buffer[PROTOCOL_FRAME_PACKED_SIZE]);
+
+ /**
+  *	Ends a DCH frame.
+  * 
+  * @param [out] buffer
+  *     Reference where store the end of the frame.
+  * 
+  * @return The length of the end of the frame.
+  *
+  * @see protocol_initDCH()
+  */
+ uint16_t protocol_endDCH(uint8_t buffer[PROTOCOL_FRAME_END_SIZE]);
+
+ // CHS
+ 
+ /**
+  *	Create a CHS frame.
+  * 
+  * @param [in]  sChs
+  *     Reference to the container where find data to put in the frame.
+  * @param [out] buffer
+  *     Reference where store the computed frame.
+  * 
+  * @return The length of the frame.
+  *
+  * @see protocol_parseCHS()
+  * @see health_getReport()
+  */
+ uint16_t protocol_createCHS(struct sProtocolCHS const* sChs, tProtocol_bufferCHS buffer);
  
  #ifdef __cplusplus
   }
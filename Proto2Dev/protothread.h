@@ -0,0 +1,89 @@
+/**
+ *  Stackless cooperative threads (protothreads).
+ *
+ *  A protothread is a function resumed where it last waited : its position
+ *  is kept as a line number in a 2 bytes state, a switch jumps back to it.
+ *  Several activities so share the single stack of the AVR, each waiting
+ *  without blocking the others, for the cost of its state only. The same
+ *  macros run unchanged in a host build.
+ *
+ *  @warning Local variables don't survive a wait : what must be kept goes
+ *      in static variables. No switch statement may enclose a wait.
+ *
+ *  @file protothread.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef PROTOTHREAD_H
+ #define PROTOTHREAD_H
+
+ #include <inttypes.h>
+
+ /**
+  *	Results of a protothread.
+  */
+ #define PT_WAITING                 0
+ #define PT_YIELDED                 1
+ #define PT_EXITED                  2
+ #define PT_ENDED                   3
+
+ /**
+  *	State of a protothread.
+  */
+ struct sProtothread
+ {
+    uint16_t lc;    /**< Line where resume, 0 at the beginning. */
+ };
+
+ /**
+  * @def    PT_THREAD(nameArgs)
+  * @brief  Declares a protothread, returning one of the PT_XXX results.
+  */
+ #define PT_THREAD(nameArgs)        char nameArgs
+ /**
+  * @def    PT_INIT(pt)
+  * @brief  Restarts a protothread from its beginning.
+  */
+ #define PT_INIT(pt)                ((pt)->lc = 0)
+ /**
+  * @def    PT_BEGIN(pt)
+  * @brief  Starts the body of a protothread.
+  */
+ #define PT_BEGIN(pt)               { char ptYielded = 1; (void)ptYielded; switch ((pt)->lc) { case 0:
+ /**
+  * @def    PT_END(pt)
+  * @brief  Ends the body of a protothread, restarted by the next call.
+  */
+ #define PT_END(pt)                 } ptYielded = 0; PT_INIT(pt); return PT_ENDED; }
+ /**
+  * @def    PT_WAIT_UNTIL(pt, condition)
+  * @brief  Waits until a condition is true, checked at each call.
+  */
+ #define PT_WAIT_UNTIL(pt, condition)   \
+    do { (pt)->lc = __LINE__; case __LINE__: if (!(condition)) return PT_WAITING; } while (0)
+ /**
+  * @def    PT_WAIT_WHILE(pt, condition)
+  * @brief  Waits while a condition is true, checked at each call.
+  */
+ #define PT_WAIT_WHILE(pt, condition)   PT_WAIT_UNTIL((pt), !(condition))
+ /**
+  * @def    PT_YIELD(pt)
+  * @brief  Gives way to the other activities until the next call.
+  */
+ #define PT_YIELD(pt)                   \
+    do { ptYielded = 0; (pt)->lc = __LINE__; case __LINE__: if (ptYielded == 0) return PT_YIELDED; } while (0)
+ /**
+  * @def    PT_EXIT(pt)
+  * @brief  Leaves a protothread, restarted by the next call.
+  */
+ #define PT_EXIT(pt)                do { PT_INIT(pt); return PT_EXITED; } while (0)
+ /**
+  * @def    PT_SCHEDULE(call)
+  * @brief  Runs a protothread once, true while it hasn't ended.
+  */
+ #define PT_SCHEDULE(call)          ((call) < PT_EXITED)
+#endif
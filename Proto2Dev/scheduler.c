@@ -0,0 +1,83 @@
+/**
+ *  @copybrief scheduler.h
+ *  @copydetails scheduler.h
+ *
+ *  @file scheduler.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "scheduler.h"
+
+/**
+ *	Deadline of the task being run.
+ *
+ *  @internal
+ */
+static uint32_t scheduler_deadline = 0;
+
+void scheduler_start(struct sScheduler* sScheduler, struct sSchedulerTask const* tasks, const uint8_t nbTask, const uint32_t duration)
+{
+    uint8_t iter;
+    uint32_t now;
+
+    assert(sScheduler != NULL);
+    assert(tasks != NULL);
+    assert(nbTask > 0 && nbTask <= SCHEDULER_TASK_MAX);
+
+    now = scheduler_millis();
+    sScheduler->tasks = tasks;
+    sScheduler->nbTask = nbTask;
+    sScheduler->end = now + duration;
+    for (iter = 0 ; iter < nbTask ; iter++)
+        sScheduler->deadlines[iter] = now + progmem_readDword(&tasks[iter].offset);
+}
+
+bool scheduler_run(struct sScheduler* sScheduler, void* context)
+{
+    struct sSchedulerTask task;
+    eSchedulerResult result;
+    uint8_t next;
+    uint8_t iter;
+    uint32_t now;
+    int32_t wait;
+
+    assert(sScheduler != NULL);
+
+    for (;;)
+    {
+        /* Earliest deadline first, the first task of the table on a tie. */
+        next = 0;
+        for (iter = 1 ; iter < sScheduler->nbTask ; iter++)
+            if ((int32_t)(sScheduler->deadlines[iter] - sScheduler->deadlines[next]) < 0)
+                next = iter;
+        now = scheduler_millis();
+        if ((int32_t)(now - sScheduler->end) >= 0)
+            return false;
+        wait = (int32_t)(sScheduler->deadlines[next] - now);
+        if (wait > 0)
+        {
+            if (scheduler_sleep((uint32_t)wait, sScheduler->end))
+                return false;
+            now = scheduler_millis();
+        }
+        progmem_memcpy(&task, &sScheduler->tasks[next], sizeof(task));
+        if ((int32_t)(now - sScheduler->deadlines[next]) >= (int32_t)*task.period)
+            probe_count(cProbeCounterLate);
+        scheduler_deadline = sScheduler->deadlines[next];
+        result = task.run(context);
+        if (result == cSchedulerRetry)
+            return true;
+        sScheduler->deadlines[next] += *task.period;
+        if (result == cSchedulerLeave)
+            return true;
+    }
+}
+
+uint32_t scheduler_getDeadline(void)
+{
+    return scheduler_deadline;
+}
@@ -0,0 +1,135 @@
+/**
+ *  Earliest deadline first scheduler of the periodic tasks.
+ *
+ *  The tasks of a mode are given by a constant table in program memory :
+ *  the reference of their period, so a period changed by the configuration
+ *  applies from the next deadline, the offset of their first deadline and
+ *  their handler. The task of the earliest deadline runs first, the first
+ *  one of the table on a tie, so tasks of commensurate periods run on the
+ *  same tick in a known order. In between, the bed sensor sleeps through a
+ *  user set function until the next deadline.
+ *
+ *  A task run a period or more after its deadline is an overrun, counted by
+ *  the cProbeCounterLate counter. Its following deadlines aren't shifted, so
+ *  the samples keep their period on average.
+ *
+ *  @file scheduler.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef SCHEDULER_H
+ #define SCHEDULER_H
+
+ #include <inttypes.h>
+ #include <string.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "progmem.h"
+ #include "probe.h"
+
+ /**
+  *	Maximum number of tasks of a table.
+  */
+ #define SCHEDULER_TASK_MAX         4
+
+ /**
+  *	Enumeration of the results of a task.
+  */
+ typedef enum
+ {
+    cSchedulerNext = 0, /**< Done, on with the next deadline. */
+    cSchedulerLeave,    /**< Done, scheduler_run() returns to its caller. */
+    cSchedulerRetry     /**< Not done, scheduler_run() returns and the task is due again at once. */
+ } eSchedulerResult;
+
+ /**
+  *	Periodic task.
+  */
+ struct sSchedulerTask
+ {
+    uint32_t const* period;                         /**< Reference to the period in ms. */
+    uint32_t offset;                                /**< Delay of the first deadline after scheduler_start() in ms. */
+    eSchedulerResult (*run)(void* context);         /**< Handler of the task. */
+ };
+
+ /**
+  *	State of a scheduler.
+  */
+ struct sScheduler
+ {
+    struct sSchedulerTask const* tasks;             /**< Table of the tasks in program memory. */
+    uint32_t deadlines[SCHEDULER_TASK_MAX];         /**< Next deadline of each task in ms. */
+    uint32_t end;                                   /**< Time at which scheduler_run() returns in ms. */
+    uint8_t nbTask;                                 /**< Number of tasks of the table. */
+ };
+
+ /**
+  *	Reference of the function sleeping until a deadline.
+  *
+  *  This function should return true if it returned at end, before the
+  *  deadline, false otherwise.
+  *
+  *  @warning It must be set by user.
+  */
+ extern bool (*scheduler_sleep)(const uint32_t delay, const uint32_t end);
+ /**
+  *	Reference of the function giving the time in ms.
+  *
+  *  @warning It must be set by user.
+  */
+ extern uint32_t (*scheduler_millis)(void);
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Starts a table of tasks.
+  *
+  *  @param [out] sScheduler
+  *      Reference to the state.
+  *  @param [in] tasks
+  *      Reference to the table, in program memory.
+  *  @param [in] nbTask
+  *      Number of tasks of the table, SCHEDULER_TASK_MAX at most.
+  *  @param [in] duration
+  *      Time after which scheduler_run() returns in ms.
+  */
+ void scheduler_start(struct sScheduler* sScheduler, struct sSchedulerTask const* tasks, const uint8_t nbTask, const uint32_t duration);
+
+ /**
+  *	Runs the tasks until one of them leaves or until the end.
+  *
+  *  The deadlines are kept between two calls, so the tasks go on after
+  *  their caller has emptied its buffer.
+  *
+  *  @param [in,out] sScheduler
+  *      Reference to the state.
+  *  @param [in,out] context
+  *      Reference given to the handlers.
+  *
+  *  @return true if a task left, false at the end.
+  */
+ bool scheduler_run(struct sScheduler* sScheduler, void* context);
+
+ /**
+  *	Gives the deadline of the task being run.
+  *
+  *  @note The task started late if it's past.
+  *
+  *  @return The deadline in ms.
+  */
+ uint32_t scheduler_getDeadline(void);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
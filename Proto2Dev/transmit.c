@@ -0,0 +1,1136 @@
+/**
+ *  @copybrief transmit.h
+ *  @copydetails transmit.h
+ *
+ *  @file transmit.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "transmit.h"
+
+/**
+ *	Capacity of the spool in bytes.
+ *
+ *  @internal
+ */
+#define TRANSMIT_SPOOL_CAPACITY    ((uint32_t)(TRANSMIT_SPOOL_END) - (TRANSMIT_SPOOL_BEGIN))
+/**
+ *	Number of segments of the spool.
+ *
+ *  @internal
+ */
+#define TRANSMIT_INDEX_NUMBER      ((TRANSMIT_SPOOL_CAPACITY + (TRANSMIT_INDEX_SEGMENT) - 1) / (TRANSMIT_INDEX_SEGMENT))
+/**
+ *	Value of transmit_openPos or of an offset in the index when there is nothing.
+ *
+ *  @internal
+ */
+#define TRANSMIT_NO_PACKET         UINT16_MAX
+/**
+ *	Value of transmit_resendAddr before the search of the range requested.
+ *
+ *  @internal
+ */
+#define TRANSMIT_NO_ADDR           UINT32_MAX
+/**
+ *	Size of a packet's header in the queue : its size and its SEQ frame.
+ *
+ *  @internal
+ */
+#define TRANSMIT_HEADER_SIZE       (1 + (PROTOCOL_SEQ_SIZE))
+/**
+ *	Position of the sequence number in a packet's header.
+ *
+ *  @internal
+ */
+#define TRANSMIT_SEQ_POS           (1 + (PROTOCOL_FRAME_START_SIZE) + (PROTOCOL_FRAME_TYPE_SIZE) + (PROTOCOL_FRAME_SEP_SIZE))
+/**
+ *	Reads the sequence number of a packet's header.
+ *
+ *  @internal
+ */
+#define transmit_getSeq(header)    ((uint16_t)((header)[TRANSMIT_SEQ_POS] << 8) | (header)[TRANSMIT_SEQ_POS + 1])
+/**
+ *	Determines if a sequence number comes before another one, modulo 2^16.
+ *
+ *  @internal
+ */
+#define transmit_isBefore(a, b)    ((int16_t)((uint16_t)(a) - (uint16_t)(b)) < 0)
+
+/**
+ *	Enumeration of the packets handed to the radio.
+ *
+ *  @internal
+ */
+typedef enum
+{
+    cTransmitSendNew = 0,   /**< Sent for the first time, in the window. */
+    cTransmitSendResent,    /**< Sent again on request of the platform. */
+    cTransmitSendEvent      /**< Copy of event frames, ahead of the queue. */
+} eTransmitSend;
+
+/**
+ *	Queue of packets in RAM, each one after a byte giving its size.
+ *
+ *  @internal
+ */
+static uint8_t  transmit_ram[TRANSMIT_RAM_SIZE];
+static uint16_t transmit_ramSize = 0;
+static uint16_t transmit_openPos = TRANSMIT_NO_PACKET;     /**< Position of the packet being filled, always the last one. */
+
+/**
+ *	Copy of the event frames queued since the last burst, after a byte giving its size.
+ *
+ *  @internal
+ */
+static uint8_t  transmit_event[1 + TRANSMIT_EVENT_SIZE];
+static uint16_t transmit_eventNext;                        /**< Sequence number following its frames. */
+
+/**
+ *	Sequence number of the next frame queued.
+ *
+ *  @internal
+ */
+static uint16_t transmit_seq = 0;
+
+/**
+ *	Circular spool in the 24XX1026 memory, same layout than the RAM.
+ *
+ *  Packets between the head and the tail are waiting, the older ones
+ *  are kept for a retransmission until being overwritten.
+ *
+ *  @internal
+ */
+static uint32_t transmit_spoolHead = TRANSMIT_SPOOL_BEGIN;  /**< Address of the next byte written. */
+static uint32_t transmit_spoolTail = TRANSMIT_SPOOL_BEGIN;  /**< Address of the next byte sent. */
+static uint32_t transmit_spoolSize = 0;                     /**< Number of bytes waiting in the spool. */
+
+/**
+ *	First packet written in each segment of the spool since the head entered it.
+ *
+ *  @internal
+ */
+static struct
+{
+    uint16_t seq;       /**< Sequence number of the packet. */
+    uint16_t offset;    /**< Offset of the packet in the segment, TRANSMIT_NO_PACKET if none. */
+} transmit_index[TRANSMIT_INDEX_NUMBER];
+
+/**
+ *	Range of frames requested by the platform.
+ *
+ *  @internal
+ */
+static uint16_t transmit_resendFirst;
+static uint16_t transmit_resendLast;
+static bool     transmit_bResend = false;
+static uint32_t transmit_resendAddr = TRANSMIT_NO_ADDR;    /**< Address of the next packet of the spool walked through. */
+static bool     transmit_bResendRestart = false;            /**< true if the walk starts again, the request changing while a packet is sent. */
+
+/**
+ *	Packets sent and waiting for an acknowledgment, oldest first.
+ *
+ *  @internal
+ */
+static struct
+{
+    uint32_t time;      /**< Time of its last sending in ms. */
+    uint16_t first;     /**< Sequence number of its first frame. */
+    uint16_t next;      /**< Sequence number following its frames. */
+    bool     bResent;   /**< true if sent again, its round trip time being ambiguous. */
+} transmit_window[TRANSMIT_WINDOW];
+static uint8_t transmit_windowStart = 0;
+static uint8_t transmit_windowSize  = 0;
+
+/**
+ *	Last acknowledgment of the platform.
+ *
+ *  @internal
+ */
+static uint16_t transmit_cumSeq      = 0;       /**< First frame not received. */
+static uint16_t transmit_ackSeq      = 0;       /**< First frame waiting for an acknowledgment, after the ones left to the NAK frames. */
+static uint16_t transmit_ackMask     = 0;       /**< Frames received after it. */
+static uint16_t transmit_seqSent     = 0;       /**< Sequence number following the frames sent. */
+static bool     transmit_bFastResent = false;   /**< true if the first hole is sent again already. */
+static uint8_t  transmit_nbTimeouts  = 0;       /**< Number of consecutive timeouts without acknowledgment. */
+
+/**
+ *	Round trip time estimator, in ms.
+ *
+ *  @internal
+ */
+static uint32_t transmit_srtt   = 0;                    /**< Smoothed round trip time times 8, 0 before the first measure. */
+static uint32_t transmit_rttvar = 0;                    /**< Mean deviation of the round trip time times 4. */
+static uint16_t transmit_rto    = TRANSMIT_RTO_INIT;    /**< Timeout of the acknowledgments. */
+
+/**
+ *	Oldest deadline of the queued frames.
+ *
+ *  @internal
+ */
+static uint32_t transmit_deadline = 0;
+
+/**
+ *	Maximum latency of each class of frames.
+ *
+ *  @internal
+ */
+static uint32_t transmit_latency[cTransmitClassNumber];
+
+/**
+ *	Statistics of the scheduler.
+ *
+ *  @internal
+ */
+static struct sTransmitStats transmit_stats;
+
+/**
+ *	Burst under way, its protothread and its start.
+ *
+ *  @internal
+ */
+static bool transmit_bBurst = false;
+static struct sProtothread transmit_pt;
+static uint32_t transmit_burstStart;
+
+/**
+ *	Packet handed to the radio, waiting for its delivery status.
+ *
+ *  @internal
+ */
+static struct
+{
+    uint32_t    time;       /**< Time it was handed to the radio in ms. */
+    uint32_t    nextAddr;   /**< Address following it in the spool, TRANSMIT_NO_ADDR if it isn't kept there. */
+    uint16_t    first;      /**< Sequence number of its first frame. */
+    uint8_t     size;       /**< Size of the packet. */
+    eTransmitSend kind;     /**< Why it's sent. */
+    eXbeeStatus status;     /**< Its delivery status, cXbeeStatusPending until known. */
+} transmit_sending;
+static bool transmit_bSending = false;
+
+/**
+ *	Computes an address in the spool.
+ *
+ *  @internal
+ *
+ *  @param [in] addr
+ *      Address in the spool.
+ *  @param [in] shift
+ *      Number of bytes after addr [0;TRANSMIT_SPOOL_CAPACITY[.
+ *
+ *  @return The address, wrapped around the end of the spool.
+ */
+static uint32_t transmit_forward(const uint32_t addr, const uint32_t shift);
+
+/**
+ *	Appends a packet to the spool and indexes it.
+ *
+ *  @internal
+ *
+ *  @param [in] packet
+ *      Reference to the byte giving the size of the packet, followed by the packet.
+ *
+ *  @return true hopefully, false if the spool is full or can't be written.
+ */
+static bool transmit_spool(uint8_t const* packet);
+
+/**
+ *	Reads data from the spool.
+ *
+ *  @internal
+ *
+ *  @param [in] addr
+ *      Address in the spool.
+ *  @param [out] data
+ *      Reference where store the data.
+ *  @param [in] size
+ *      Size of data.
+ *
+ *  @return true hopefully, false if the spool can't be read.
+ */
+static bool transmit_unspool(uint32_t addr, uint8_t* data, uint16_t size);
+
+/**
+ *	Moves the sealed packets in RAM to the spool.
+ *
+ *  @internal
+ *
+ *  @return true hopefully, false otherwise.
+ */
+static bool transmit_spill(void);
+
+/**
+ *	Appends a whole frame, or a part of a bigger one, to the packet being filled.
+ *
+ *  @internal
+ *
+ *  @param [in] data
+ *      Reference to the frame.
+ *  @param [in] size
+ *      Size of data [1;TRANSMIT_PACKET_SIZE - PROTOCOL_SEQ_SIZE].
+ *
+ *  @return true hopefully, false if the frame is dropped.
+ */
+static bool transmit_pack(uint8_t const* data, const uint8_t size);
+
+/**
+ *	Appends an event frame to the copy sent first by the next burst.
+ *
+ *  @internal
+ *
+ *  @param [in] data
+ *      Reference to the frame, queued already.
+ *  @param [in] size
+ *      Size of data.
+ */
+static void transmit_copyEvent(uint8_t const* data, const uint16_t size);
+
+/**
+ *	Gives the sequence number of the first frame queued in RAM.
+ *
+ *  @internal
+ */
+#define transmit_getQueuedSeq()    ((transmit_ramSize > 0) ? transmit_getSeq(transmit_ram) : transmit_seq)
+
+/**
+ *	Hands a packet to the radio, its delivery status being awaited by the burst.
+ *
+ *  @internal
+ *
+ *  @param [in] packet
+ *      Reference to the byte giving the size of the packet, followed by the packet.
+ *  @param [in] nextAddr
+ *      Address following the packet in the spool, TRANSMIT_NO_ADDR if it isn't kept there.
+ *  @param [in] kind
+ *      Why it's sent.
+ *
+ *  @return true hopefully, false if the radio doesn't take it.
+ */
+static bool transmit_handOver(uint8_t const* packet, const uint32_t nextAddr, const eTransmitSend kind);
+
+/**
+ *	Handles the delivery status of the packet handed to the radio.
+ *
+ *  @internal
+ *
+ *  @return true if the packet is delivered, false otherwise.
+ */
+static bool transmit_sent(void);
+
+/**
+ *	Sends a packet for the first time and adds it to the window.
+ *
+ *  @internal
+ *
+ *  @param [in] packet
+ *      Reference to the byte giving the size of the packet, followed by the packet.
+ *  @param [in] next
+ *      Sequence number following the frames of the packet.
+ *  @param [in] nextAddr
+ *      Address following the packet in the spool, TRANSMIT_NO_ADDR if it isn't kept there.
+ *
+ *  @return true hopefully, false if the radio doesn't take it.
+ */
+static bool transmit_sendNew(uint8_t const* packet, const uint16_t next, const uint32_t nextAddr);
+
+/**
+ *	Updates the timeout with a round trip time.
+ *
+ *  @internal
+ *
+ *  @param [in] rtt
+ *      Round trip time of a packet sent once in ms.
+ */
+static void transmit_measure(const uint32_t rtt);
+
+/**
+ *	Gives the last frame of the first hole acknowledged by the platform.
+ *
+ *  @internal
+ *
+ *  @return The sequence number of the frame, the last one sent if there is no hole.
+ */
+static uint16_t transmit_getHoleEnd(void);
+
+/**
+ *	Requests a range of frames of the window to be sent again.
+ *
+ *  @internal
+ *
+ *  @param [in] first
+ *      Sequence number of the first frame.
+ *  @param [in] last
+ *      Sequence number of the last frame.
+ */
+static void transmit_retransmit(const uint16_t first, const uint16_t last);
+
+/**
+ *	Handles the lack of acknowledgment of the oldest packet of the window.
+ *
+ *  @internal
+ */
+static void transmit_timeout(void);
+
+/**
+ *	Sends again the next packet of the spool holding the range requested by the platform.
+ *
+ *  @internal
+ *
+ *  One packet of the spool is walked through at each call, so a step of a
+ *  burst reads one packet at most. The request is over once the range is.
+ *
+ *  @param [out] packet
+ *      Buffer for the packets read from the spool.
+ *
+ *  @return true hopefully, false if a packet can't be read or handed to the radio.
+ */
+static bool transmit_sendRange(uint8_t packet[1 + TRANSMIT_PACKET_SIZE]);
+
+/**
+ *	Sends the queue in a burst, yielding while waiting for acknowledgments.
+ *
+ *  @internal
+ *
+ *  Frames may be queued between two steps : they leave in the same burst.
+ *
+ *  @param [in,out] pt
+ *      State of the protothread.
+ *
+ *  @return PT_YIELDED while the burst goes on, PT_ENDED at its end.
+ */
+static PT_THREAD(transmit_burst(struct sProtothread* pt));
+
+static uint32_t transmit_forward(const uint32_t addr, const uint32_t shift)
+{
+    return (addr - TRANSMIT_SPOOL_BEGIN + shift) % TRANSMIT_SPOOL_CAPACITY + TRANSMIT_SPOOL_BEGIN;
+}
+
+static bool transmit_spool(uint8_t const* packet)
+{
+    uint32_t start;
+    uint32_t offset;
+    uint32_t chunk;
+    uint16_t size;
+    uint8_t const* data;
+
+    size = 1 + packet[0];
+    if (size > TRANSMIT_SPOOL_CAPACITY - transmit_spoolSize)
+        return false;
+
+    start = transmit_spoolHead - TRANSMIT_SPOOL_BEGIN;
+    offset = start;
+    data = packet;
+    while (size > 0)
+    {
+        /* Stops at the end of segments so entering one is noticed. */
+        chunk = TRANSMIT_INDEX_SEGMENT - offset % TRANSMIT_INDEX_SEGMENT;
+        if (chunk > TRANSMIT_SPOOL_END - transmit_spoolHead)
+            chunk = TRANSMIT_SPOOL_END - transmit_spoolHead;
+        if (chunk > size)
+            chunk = size;
+        if (!transmit_spoolWrite(transmit_spoolHead, data, chunk))
+        {
+            transmit_spoolSize -= (transmit_spoolHead - TRANSMIT_SPOOL_BEGIN + TRANSMIT_SPOOL_CAPACITY - start) % TRANSMIT_SPOOL_CAPACITY;
+            transmit_spoolHead = start + TRANSMIT_SPOOL_BEGIN;
+            return false;
+        }
+        transmit_spoolHead = transmit_forward(transmit_spoolHead, chunk);
+        transmit_spoolSize += chunk;
+        data += chunk;
+        size -= chunk;
+
+        offset = transmit_spoolHead - TRANSMIT_SPOOL_BEGIN;
+        if (offset % TRANSMIT_INDEX_SEGMENT == 0)
+        {
+            /* Older packets of this segment are about to be overwritten. */
+            transmit_index[offset / TRANSMIT_INDEX_SEGMENT].offset = TRANSMIT_NO_PACKET;
+            if (transmit_resendAddr != TRANSMIT_NO_ADDR && (transmit_resendAddr - TRANSMIT_SPOOL_BEGIN) / TRANSMIT_INDEX_SEGMENT == offset / TRANSMIT_INDEX_SEGMENT)
+            {
+                transmit_resendAddr = TRANSMIT_NO_ADDR;
+                transmit_bResendRestart = true;
+            }
+        }
+    }
+
+    if (transmit_index[start / TRANSMIT_INDEX_SEGMENT].offset == TRANSMIT_NO_PACKET)
+    {
+        transmit_index[start / TRANSMIT_INDEX_SEGMENT].seq    = transmit_getSeq(packet);
+        transmit_index[start / TRANSMIT_INDEX_SEGMENT].offset = start % TRANSMIT_INDEX_SEGMENT;
+    }
+
+    return true;
+}
+
+static bool transmit_unspool(uint32_t addr, uint8_t* data, uint16_t size)
+{
+    uint32_t chunk;
+
+    while (size > 0)
+    {
+        chunk = TRANSMIT_SPOOL_END - addr;
+        if (chunk > size)
+            chunk = size;
+        if (!transmit_spoolRead(addr, data, chunk))
+            return false;
+        addr = transmit_forward(addr, chunk);
+        data += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+static bool transmit_spill(void)
+{
+    uint16_t sealedSize;
+    uint16_t pos;
+
+    sealedSize = (transmit_openPos == TRANSMIT_NO_PACKET) ? transmit_ramSize : transmit_openPos;
+    for (pos = 0 ; pos < sealedSize ; pos += 1 + transmit_ram[pos])
+    {
+        if (!transmit_spool(transmit_ram + pos))
+            break;
+    }
+    if (pos == 0)
+        return (sealedSize == 0);
+
+    /* The packet being filled stays in RAM. */
+    memmove(transmit_ram, transmit_ram + pos, transmit_ramSize - pos);
+    transmit_ramSize -= pos;
+    if (transmit_openPos != TRANSMIT_NO_PACKET)
+        transmit_openPos -= pos;
+
+    return (pos == sealedSize);
+}
+
+static bool transmit_pack(uint8_t const* data, const uint8_t size)
+{
+    uint16_t needed;
+
+    /* Seal the packet if the frame doesn't fit entirely. */
+    if (transmit_openPos != TRANSMIT_NO_PACKET && transmit_ram[transmit_openPos] + size > TRANSMIT_PACKET_SIZE)
+        transmit_openPos = TRANSMIT_NO_PACKET;
+
+    needed = size + ((transmit_openPos == TRANSMIT_NO_PACKET) ? TRANSMIT_HEADER_SIZE : 0);
+    if (transmit_ramSize + needed > TRANSMIT_RAM_SIZE && !transmit_spill())
+        return false;
+
+    if (transmit_openPos == TRANSMIT_NO_PACKET)
+    {
+        transmit_openPos = transmit_ramSize;
+        transmit_ram[transmit_ramSize] = protocol_createSEQ(transmit_seq, transmit_ram + transmit_ramSize + 1);
+        transmit_ramSize += TRANSMIT_HEADER_SIZE;
+    }
+    memcpy(transmit_ram + transmit_ramSize, data, size);
+    transmit_ramSize += size;
+    transmit_ram[transmit_openPos] += size;
+
+    return true;
+}
+
+static void transmit_copyEvent(uint8_t const* data, const uint16_t size)
+{
+    uint8_t header;
+
+    /* Consecutive frames only : the platform numbers them from the SEQ frame. */
+    if (transmit_event[0] == 0)
+        header = protocol_createSEQ(transmit_seq, transmit_event + 1);
+    else if (transmit_eventNext == transmit_seq)
+        header = 0;
+    else
+        return;
+
+    if (transmit_event[0] + header + size > TRANSMIT_EVENT_SIZE)
+        return;
+    memcpy(transmit_event + 1 + transmit_event[0] + header, data, size);
+    transmit_event[0] += header + size;
+    transmit_eventNext = transmit_seq + 1;
+}
+
+static bool transmit_sendRange(uint8_t packet[1 + TRANSMIT_PACKET_SIZE])
+{
+    uint8_t header[TRANSMIT_HEADER_SIZE];
+    uint32_t addr;
+    uint32_t nextAddr;
+    uint32_t offset;
+    uint16_t seq;
+    uint16_t nextSeq;
+    uint8_t iterSegment;
+    uint8_t segment;
+    bool bFound = false;
+
+    if (transmit_resendAddr == TRANSMIT_NO_ADDR)
+    {
+        /* Latest indexed packet not after the first frame requested, from the oldest segment. */
+        segment = (transmit_spoolHead - TRANSMIT_SPOOL_BEGIN) / TRANSMIT_INDEX_SEGMENT;
+        addr = transmit_spoolTail;
+        for (iterSegment = 0 ; iterSegment < TRANSMIT_INDEX_NUMBER ; iterSegment++)
+        {
+            segment = (segment + 1) % TRANSMIT_INDEX_NUMBER;
+            if (transmit_index[segment].offset == TRANSMIT_NO_PACKET)
+                continue;
+            offset = (uint32_t)segment * TRANSMIT_INDEX_SEGMENT + transmit_index[segment].offset;
+            /* Packets still waiting in the spool will be sent anyway. */
+            if ((offset + TRANSMIT_SPOOL_BEGIN + TRANSMIT_SPOOL_CAPACITY - transmit_spoolTail) % TRANSMIT_SPOOL_CAPACITY < transmit_spoolSize)
+                break;
+            if (bFound && transmit_isBefore(transmit_resendFirst, transmit_index[segment].seq))
+                break;
+            addr = offset + TRANSMIT_SPOOL_BEGIN;
+            bFound = true;
+        }
+        if (!bFound)
+        {
+            transmit_bResend = false;
+            return true;
+        }
+        transmit_resendAddr = addr;
+    }
+
+    /* Packets are walked up to the last frame requested. */
+    addr = transmit_resendAddr;
+    if (addr == transmit_spoolTail)
+    {
+        transmit_bResend = false;
+        transmit_resendAddr = TRANSMIT_NO_ADDR;
+        return true;
+    }
+    /* A failure walks the range again from its start, the spool may change meanwhile. */
+    transmit_resendAddr = TRANSMIT_NO_ADDR;
+    if (!transmit_unspool(addr, header, TRANSMIT_HEADER_SIZE))
+        return false;
+    seq = transmit_getSeq(header);
+    if (transmit_isBefore(transmit_resendLast, seq))
+    {
+        transmit_bResend = false;
+        return true;
+    }
+
+    nextAddr = transmit_forward(addr, 1 + header[0]);
+    if (nextAddr == transmit_spoolTail && transmit_spoolSize == 0)
+        nextSeq = transmit_getQueuedSeq();
+    else if (transmit_unspool(nextAddr, packet, TRANSMIT_HEADER_SIZE))
+        nextSeq = transmit_getSeq(packet);
+    else
+        return false;
+
+    /* The packet holds frames [seq;nextSeq[, or a part of frame seq if they are equal. */
+    if (nextSeq == seq || transmit_isBefore(transmit_resendFirst, nextSeq))
+    {
+        /* The radio is polled until the status : a NAK may come and restart the walk. */
+        transmit_bResendRestart = false;
+        return transmit_unspool(addr, packet, 1 + header[0]) && transmit_handOver(packet, nextAddr, cTransmitSendResent);
+    }
+    transmit_resendAddr = nextAddr;
+
+    return true;
+}
+
+static bool transmit_handOver(uint8_t const* packet, const uint32_t nextAddr, const eTransmitSend kind)
+{
+    if (!transmit_radioSend(packet + 1, packet[0]))
+        return false;
+
+    transmit_sending.time     = transmit_millis();
+    transmit_sending.nextAddr = nextAddr;
+    transmit_sending.first    = transmit_getSeq(packet);
+    transmit_sending.size     = packet[0];
+    transmit_sending.kind     = kind;
+    transmit_sending.status   = cXbeeStatusPending;
+    transmit_bSending = true;
+
+    return true;
+}
+
+static bool transmit_sent(void)
+{
+    transmit_bSending = false;
+
+    /* The frames of the copy leave with the queue anyway. */
+    if (transmit_sending.kind == cTransmitSendEvent)
+        return true;
+
+    if (transmit_sending.kind == cTransmitSendResent)
+    {
+        /* The walk starts again from the range's start after a failure. */
+        if (transmit_sending.status != cXbeeStatusSuccess)
+            return false;
+        transmit_stats.nbResent++;
+        if (!transmit_bResendRestart)
+            transmit_resendAddr = transmit_sending.nextAddr;
+        return true;
+    }
+
+    if (transmit_sending.status != cXbeeStatusSuccess)
+    {
+        if (transmit_windowSize > 0 && transmit_window[(transmit_windowStart + transmit_windowSize - 1) % TRANSMIT_WINDOW].first == transmit_sending.first)
+            transmit_windowSize--;
+        transmit_seqSent = transmit_sending.first;
+        return false;
+    }
+    transmit_stats.nbBytes += transmit_sending.size;
+    transmit_stats.nbPackets++;
+    /* Packets spilled meanwhile wait after it. */
+    if (transmit_sending.nextAddr != TRANSMIT_NO_ADDR)
+    {
+        transmit_spoolTail = transmit_sending.nextAddr;
+        transmit_spoolSize -= 1 + transmit_sending.size;
+    }
+
+    return true;
+}
+
+static bool transmit_sendNew(uint8_t const* packet, const uint16_t next, const uint32_t nextAddr)
+{
+    uint8_t entry;
+    uint16_t first;
+
+    first = transmit_getSeq(packet);
+
+    /* In the window before the sending : the acknowledgment could come while waiting for the radio. */
+    entry = (transmit_windowStart + transmit_windowSize) % TRANSMIT_WINDOW;
+    transmit_window[entry].time    = transmit_millis();
+    transmit_window[entry].first   = first;
+    transmit_window[entry].next    = next;
+    transmit_window[entry].bResent = false;
+    transmit_windowSize++;
+    transmit_seqSent = next;
+
+    if (!transmit_handOver(packet, nextAddr, cTransmitSendNew))
+    {
+        if (transmit_windowSize > 0 && transmit_window[(transmit_windowStart + transmit_windowSize - 1) % TRANSMIT_WINDOW].first == first)
+            transmit_windowSize--;
+        transmit_seqSent = first;
+        return false;
+    }
+
+    return true;
+}
+
+static void transmit_measure(const uint32_t rtt)
+{
+    int32_t err;
+    uint32_t rto;
+
+    if (transmit_srtt == 0)
+    {
+        transmit_srtt   = rtt << 3;
+        transmit_rttvar = rtt << 1;
+    }
+    else
+    {
+        /* SRTT += (RTT - SRTT) / 8 ; RTTVAR += (|RTT - SRTT| - RTTVAR) / 4 */
+        err = (int32_t)(rtt - (transmit_srtt >> 3));
+        transmit_srtt += err;
+        if (err < 0)
+            err = -err;
+        err -= transmit_rttvar >> 2;
+        transmit_rttvar += err;
+    }
+
+    /* RTO = SRTT + 4 * RTTVAR */
+    rto = (transmit_srtt >> 3) + transmit_rttvar;
+    if (rto < TRANSMIT_RTO_MIN)
+        rto = TRANSMIT_RTO_MIN;
+    else if (rto > TRANSMIT_RTO_MAX)
+        rto = TRANSMIT_RTO_MAX;
+    transmit_rto = rto;
+}
+
+static uint16_t transmit_getHoleEnd(void)
+{
+    uint8_t bit;
+
+    if (transmit_ackMask == 0)
+        return transmit_seqSent - 1;
+
+    for (bit = 0 ; (transmit_ackMask & (1U << bit)) == 0 ; bit++)
+        ;
+
+    /* The copy of events is received ahead of the frames not sent yet, they aren't lost. */
+    return transmit_isBefore(transmit_ackSeq + bit, transmit_seqSent) ? transmit_ackSeq + bit : transmit_seqSent - 1;
+}
+
+static void transmit_retransmit(const uint16_t first, const uint16_t last)
+{
+    uint8_t iterEntry;
+    uint8_t entry;
+
+    transmit_resend(first, last);
+
+    /* Karn : the acknowledgment of a packet sent again doesn't measure anything. */
+    for (iterEntry = 0 ; iterEntry < transmit_windowSize ; iterEntry++)
+    {
+        entry = (transmit_windowStart + iterEntry) % TRANSMIT_WINDOW;
+        if (!transmit_isBefore(last, transmit_window[entry].first))
+            transmit_window[entry].bResent = true;
+    }
+}
+
+static void transmit_timeout(void)
+{
+    uint8_t iterEntry;
+
+    /* Only empty packets are waiting : nothing to lose. */
+    if (!transmit_isBefore(transmit_ackSeq, transmit_seqSent))
+    {
+        transmit_windowSize = 0;
+        return;
+    }
+
+    transmit_nbTimeouts++;
+    transmit_stats.nbTimeouts++;
+
+    transmit_retransmit(transmit_ackSeq, transmit_getHoleEnd());
+    transmit_bFastResent = true;
+    for (iterEntry = 0 ; iterEntry < transmit_windowSize ; iterEntry++)
+        transmit_window[(transmit_windowStart + iterEntry) % TRANSMIT_WINDOW].time = transmit_millis();
+
+    /* Back off until a new measure. */
+    transmit_rto = (transmit_rto > TRANSMIT_RTO_MAX / 2) ? TRANSMIT_RTO_MAX : 2 * transmit_rto;
+}
+
+void transmit_init(void)
+{
+    uint8_t iterSegment;
+
+    transmit_ramSize   = 0;
+    transmit_openPos   = TRANSMIT_NO_PACKET;
+    transmit_event[0]  = 0;
+    transmit_spoolHead = transmit_spoolTail = TRANSMIT_SPOOL_BEGIN;
+    transmit_spoolSize = 0;
+    transmit_bResend   = false;
+    transmit_resendAddr = TRANSMIT_NO_ADDR;
+    transmit_bResendRestart = false;
+    transmit_windowSize  = 0;
+    transmit_cumSeq      = transmit_ackSeq = transmit_seqSent = transmit_seq;
+    transmit_ackMask     = 0;
+    transmit_bFastResent = false;
+    transmit_nbTimeouts  = 0;
+    transmit_srtt        = 0;
+    transmit_rttvar      = 0;
+    transmit_rto         = TRANSMIT_RTO_INIT;
+    for (iterSegment = 0 ; iterSegment < TRANSMIT_INDEX_NUMBER ; iterSegment++)
+        transmit_index[iterSegment].offset = TRANSMIT_NO_PACKET;
+
+    transmit_latency[cTransmitClassEvent]   = TRANSMIT_LATENCY_EVENT;
+    transmit_latency[cTransmitClassSummary] = TRANSMIT_LATENCY_SUMMARY;
+    transmit_latency[cTransmitClassRaw]     = TRANSMIT_LATENCY_RAW;
+    transmit_latency[cTransmitClassAlive]   = TRANSMIT_LATENCY_ALIVE;
+
+    memset(&transmit_stats, 0, sizeof(transmit_stats));
+
+    transmit_bBurst = false;
+    transmit_bSending = false;
+    transmit_radioPower(false);
+}
+
+void transmit_setLatency(const eTransmitClass frameClass, const uint32_t latency)
+{
+    assert(frameClass < cTransmitClassNumber);
+
+    transmit_latency[frameClass] = latency;
+}
+
+bool transmit_push(uint8_t const* data, const uint16_t size, const eTransmitClass frameClass)
+{
+    uint32_t deadline;
+    uint16_t remaining;
+    uint16_t frameSize;
+    uint16_t chunk;
+    uint16_t part;
+    bool bEmpty;
+
+    assert(data != NULL);
+    assert(frameClass < cTransmitClassNumber);
+
+    if (size == 0)
+        return true;
+
+    bEmpty = transmit_isEmpty();
+
+    for (remaining = size ; remaining > 0 ; data += frameSize, remaining -= frameSize)
+    {
+        /* Unknown bytes are kept together until the end of data. */
+        frameSize = protocol_getFrameSize(data, remaining);
+        if (frameSize == 0)
+            frameSize = remaining;
+
+        if (frameSize > TRANSMIT_PACKET_SIZE - PROTOCOL_SEQ_SIZE)
+        {
+            /* Too big for a packet : split over dedicated packets. */
+            transmit_openPos = TRANSMIT_NO_PACKET;
+            for (chunk = 0 ; chunk < frameSize ; chunk += part)
+            {
+                part = frameSize - chunk;
+                if (part > TRANSMIT_PACKET_SIZE - PROTOCOL_SEQ_SIZE)
+                    part = TRANSMIT_PACKET_SIZE - PROTOCOL_SEQ_SIZE;
+                if (!transmit_pack(data + chunk, part))
+                {
+                    transmit_stats.nbDropped++;
+                    return false;
+                }
+                transmit_openPos = TRANSMIT_NO_PACKET;
+            }
+        }
+        else if (!transmit_pack(data, frameSize))
+        {
+            transmit_stats.nbDropped++;
+            return false;
+        }
+        else if (frameClass == cTransmitClassEvent)
+            transmit_copyEvent(data, frameSize);
+        transmit_seq++;
+        transmit_stats.nbFrames++;
+    }
+
+    deadline = transmit_millis() + transmit_latency[frameClass];
+    if (bEmpty || (int32_t)(deadline - transmit_deadline) < 0)
+        transmit_deadline = deadline;
+
+    return true;
+}
+
+void transmit_resend(const uint16_t first, const uint16_t last)
+{
+    if (transmit_bResend)
+    {
+        if (transmit_isBefore(first, transmit_resendFirst))
+        {
+            transmit_resendFirst = first;
+            /* Walked again from the new first frame. */
+            transmit_resendAddr = TRANSMIT_NO_ADDR;
+            transmit_bResendRestart = true;
+        }
+        if (transmit_isBefore(transmit_resendLast, last))
+            transmit_resendLast = last;
+    }
+    else
+    {
+        transmit_resendFirst = first;
+        transmit_resendLast  = last;
+        transmit_bResend     = true;
+        transmit_resendAddr  = TRANSMIT_NO_ADDR;
+        transmit_bResendRestart = true;
+    }
+
+    transmit_deadline = transmit_millis();
+}
+
+void transmit_acknowledge(const uint16_t seq, const uint16_t mask)
+{
+    bool bBack;
+
+    /* Late, or beyond the frames sent. */
+    if (transmit_isBefore(seq, transmit_cumSeq) || transmit_isBefore(transmit_seqSent, seq))
+        return;
+
+    /* The platform hears us, even if the hole stays. */
+    transmit_nbTimeouts = 0;
+    if (seq != transmit_ackSeq)
+        transmit_bFastResent = false;
+    /* The platform still misses frames left to its NAK frames : they're back in the window. */
+    bBack = transmit_isBefore(seq, transmit_ackSeq);
+    transmit_cumSeq  = transmit_ackSeq = seq;
+    transmit_ackMask = mask;
+
+    while (transmit_windowSize > 0 && !transmit_isBefore(seq, transmit_window[transmit_windowStart].next))
+    {
+        if (!transmit_window[transmit_windowStart].bResent)
+            transmit_measure(transmit_millis() - transmit_window[transmit_windowStart].time);
+        transmit_windowStart = (transmit_windowStart + 1) % TRANSMIT_WINDOW;
+        transmit_windowSize--;
+    }
+
+    /* Frames received after a hole : it's lost, don't wait for the timeout. */
+    if ((mask != 0 || bBack) && !transmit_bFastResent && transmit_isBefore(seq, transmit_seqSent))
+    {
+        transmit_retransmit(seq, transmit_getHoleEnd());
+        transmit_bFastResent = true;
+    }
+}
+
+void transmit_keepAlive(void)
+{
+    /* Anything queued goes with the next burst anyway. */
+    if (!transmit_isEmpty())
+        return;
+
+    transmit_openPos = 0;
+    transmit_ram[0] = protocol_createSEQ(transmit_seq, transmit_ram + 1);
+    transmit_ramSize = TRANSMIT_HEADER_SIZE;
+    transmit_deadline = transmit_millis() + transmit_latency[cTransmitClassAlive];
+}
+
+bool transmit_poll(void)
+{
+    if (!transmit_bBurst)
+    {
+        if (transmit_isEmpty() || (int32_t)(transmit_millis() - transmit_deadline) < 0)
+            return false;
+        PT_INIT(&transmit_pt);
+        transmit_bBurst = true;
+    }
+    transmit_bBurst = PT_SCHEDULE(transmit_burst(&transmit_pt));
+
+    return true;
+}
+
+static PT_THREAD(transmit_burst(struct sProtothread* pt))
+{
+    uint8_t packet[1 + TRANSMIT_PACKET_SIZE];
+    uint8_t header[TRANSMIT_HEADER_SIZE];
+    uint16_t next;
+    uint8_t size;
+    bool bSpooled;
+    /* Still true when resumed : the burst only yields after a success or while waiting. */
+    bool bDelivered = true;
+
+    PT_BEGIN(pt);
+
+    /* The deadline is reached : the packet being filled leaves as it is. */
+    transmit_openPos = TRANSMIT_NO_PACKET;
+
+    transmit_burstStart = transmit_millis();
+    transmit_radioPower(true);
+    transmit_stats.nbBursts++;
+
+    /* A copy of the events first, then oldest first : the lost frames, the spool, then the RAM, as long as the window allows. */
+    while (bDelivered)
+    {
+        if (transmit_windowSize > 0 && transmit_millis() - transmit_window[transmit_windowStart].time >= transmit_rto)
+        {
+            if (transmit_nbTimeouts == TRANSMIT_TIMEOUT_MAX)
+            {
+                /* The platform is silent : the window is left to its NAK frames. */
+                transmit_windowSize = 0;
+                transmit_ackSeq     = transmit_seqSent;
+                transmit_ackMask    = 0;
+                transmit_nbTimeouts = 0;
+                bDelivered = false;
+                break;
+            }
+            transmit_timeout();
+        }
+
+        if (transmit_event[0] > 0)
+        {
+            /* Best effort : a failure doesn't end the burst, the frames are queued anyway. */
+            transmit_handOver(transmit_event, TRANSMIT_NO_ADDR, cTransmitSendEvent);
+            transmit_event[0] = 0;
+        }
+        else if (transmit_bResend)
+            bDelivered = transmit_sendRange(packet);
+        else if (transmit_windowSize < TRANSMIT_WINDOW && transmit_spoolSize > 0)
+        {
+            bDelivered = transmit_unspool(transmit_spoolTail, packet, 1) && transmit_unspool(transmit_spoolTail, packet, 1 + packet[0]);
+            size = 1 + packet[0];
+            if (bDelivered && transmit_spoolSize > size)
+            {
+                bDelivered = transmit_unspool(transmit_forward(transmit_spoolTail, size), header, TRANSMIT_HEADER_SIZE);
+                next = transmit_getSeq(header);
+            }
+            else
+                next = transmit_getQueuedSeq();
+            bDelivered = bDelivered && transmit_sendNew(packet, next, transmit_forward(transmit_spoolTail, size));
+        }
+        else if (transmit_windowSize < TRANSMIT_WINDOW && transmit_ramSize > 0)
+        {
+            /* Frames queued since the burst began : their packet leaves as it is. */
+            if (transmit_openPos == 0)
+                transmit_openPos = TRANSMIT_NO_PACKET;
+            size = 1 + transmit_ram[0];
+            next = (size < transmit_ramSize) ? transmit_getSeq(transmit_ram + size) : transmit_seq;
+            /* Moved to the spool, which is empty, before the radio takes it : RAM may be spilled while waiting for
+               the status, and the spool keeps it for a retransmission. Without the spool it's lost if not delivered. */
+            bSpooled = transmit_spool(transmit_ram);
+            bDelivered = transmit_sendNew(transmit_ram, next, bSpooled ? transmit_spoolHead : TRANSMIT_NO_ADDR);
+            if (bDelivered || bSpooled)
+            {
+                memmove(transmit_ram, transmit_ram + size, transmit_ramSize - size);
+                transmit_ramSize -= size;
+                if (transmit_openPos != TRANSMIT_NO_PACKET)
+                    transmit_openPos -= size;
+            }
+        }
+        else if (transmit_windowSize > 0)
+        {
+            transmit_radioReceive();
+            /* The other activities go on while the acknowledgments come. */
+            PT_YIELD(pt);
+            continue;
+        }
+        else
+            break;
+
+        /* The serial link is slow, and the radio retries : the other activities go on until the status comes. */
+        if (transmit_bSending)
+        {
+            PT_WAIT_UNTIL(pt, (transmit_sending.status = transmit_radioStatus()) != cXbeeStatusPending || transmit_millis() - transmit_sending.time >= TRANSMIT_STATUS_TIMEOUT);
+            bDelivered = transmit_sent();
+        }
+
+        /* A packet at most through the spool in a step, so it fits before the next sweep. */
+        if (bDelivered)
+            PT_YIELD(pt);
+    }
+
+    transmit_radioPower(false);
+    transmit_stats.awakeTime += transmit_millis() - transmit_burstStart;
+
+    if (!bDelivered)
+    {
+        /* The platform is out of reach, or deaf : don't wake the radio for each new frame. */
+        transmit_stats.nbFailures++;
+        transmit_deadline = transmit_millis() + TRANSMIT_RETRY_DELAY;
+    }
+
+    PT_END(pt);
+}
+
+bool transmit_flush(void)
+{
+    if (!transmit_bBurst)
+    {
+        if (transmit_isEmpty())
+            return true;
+        PT_INIT(&transmit_pt);
+        transmit_bBurst = true;
+    }
+    while (PT_SCHEDULE(transmit_burst(&transmit_pt)))
+        ;
+    transmit_bBurst = false;
+
+    return transmit_isEmpty();
+}
+
+uint32_t transmit_getDelay(void)
+{
+    int32_t delay;
+
+    if (transmit_bBurst)
+        return 0;
+    if (transmit_isEmpty())
+        return UINT32_MAX;
+
+    delay = transmit_deadline - transmit_millis();
+
+    return (delay < 0) ? 0 : delay;
+}
+
+bool transmit_isEmpty(void)
+{
+    return (transmit_ramSize == 0 && transmit_spoolSize == 0 && !transmit_bResend && transmit_windowSize == 0 && !transmit_bBurst);
+}
+
+void transmit_getStats(struct sTransmitStats* sStats)
+{
+    assert(sStats != NULL);
+
+    *sStats = transmit_stats;
+    sStats->rto = transmit_rto;
+}
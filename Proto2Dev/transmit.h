@@ -0,0 +1,328 @@
+/**
+ *  Transmit scheduler duty-cycling the radio.
+ *
+ *  Frames are packed whole into packets filled up to the radio's payload,
+ *  so each packet is decoded on its own by the platform. Packets are queued
+ *  in RAM, then spilled into a spool in the 24XX1026 memory when RAM is full.
+ *  The radio is woken up through its sleep pin only when the oldest deadline
+ *  of the queued frames is reached : the packet being filled is sealed early,
+ *  everything is sent in one burst and the radio goes back to sleep.
+ *  Each class of frames has its own maximum latency, a null latency triggers
+ *  a burst at once. A copy of the event frames is sent first by the burst,
+ *  ahead of the lost frames and of the spool, while the frames themselves
+ *  leave in order with the others : numbered alike, the platform tells the
+ *  copy from the original.
+ *
+ *  Each packet starts with a SEQ frame numbering its frames, and stays in the
+ *  spool once sent. A coarse index gives the first packet of each segment of
+ *  the spool, so a range of frames lost by the platform (NAK) is found and
+ *  sent again without reading the whole spool.
+ *
+ *  The platform acknowledges the frames received with ACK frames, cumulative
+ *  up to its first missing frame and selective over the following ones.
+ *  At most TRANSMIT_WINDOW packets wait for an acknowledgment : the radio
+ *  stays awake until they are acknowledged. A hole reported by the platform
+ *  is sent again at once, the whole window when no acknowledgment comes in
+ *  time. The timeout follows the measured round trip time (Jacobson/Karels).
+ *
+ *  A burst is a protothread : after each packet, while the radio delivers
+ *  it and while waiting for acknowledgments, transmit_poll() returns, so
+ *  sampling and commands go on between two steps, and frames queued
+ *  meanwhile leave in the same burst. A step moves one packet at most
+ *  through the spool and the serial link.
+ *
+ *  The radio, the memory and the clock are reached through user set
+ *  functions, so the scheduler runs against a simulated link on a host
+ *  and its statistics give the energy spent per delivered byte.
+ *
+ *  @file transmit.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef TRANSMIT_H
+ #define TRANSMIT_H
+
+ #include <inttypes.h>
+ #include <string.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "protocol.h"
+ #include "protothread.h"
+ #include "xbee.h"
+
+ /**
+  *	Maximum size of the packets sent to the radio in bytes.
+  *
+  *  @note Frames bigger than a packet are split over consecutive packets.
+  */
+ #define TRANSMIT_PACKET_SIZE       XBEE_PAYLOAD_MAX
+ /**
+  *	Size of the queue in RAM in bytes.
+  *
+  *  @note Each packet is queued after a byte giving its size.
+  */
+ #ifndef TRANSMIT_RAM_SIZE
+  #define TRANSMIT_RAM_SIZE         128
+ #endif
+ #if TRANSMIT_RAM_SIZE < TRANSMIT_PACKET_SIZE + 1
+  #error "TRANSMIT_RAM_SIZE must hold a packet and its size"
+ #endif
+ /**
+  *	Size of the copy of the event frames sent first by a burst in bytes.
+  *
+  *  @note Holds a SEQ frame, an EVT frame and a BAT frame.
+  */
+ #define TRANSMIT_EVENT_SIZE        ((PROTOCOL_SEQ_SIZE) + (PROTOCOL_EVT_SIZE) + (PROTOCOL_BAT_SIZE))
+ /**
+  *	First address of the spool in the 24XX1026 memory.
+  *
+  *  @note The first pages are left to the calibration and the configuration.
+  */
+ #define TRANSMIT_SPOOL_BEGIN       0x00100
+ /**
+  *	Address following the spool in the 24XX1026 memory.
+  */
+ #define TRANSMIT_SPOOL_END         0x20000
+ /**
+  *	Size of the segments of the spool indexed by sequence number in bytes.
+  */
+ #define TRANSMIT_INDEX_SEGMENT     8192
+ /**
+  *	Delay before a new burst after a failed one in ms.
+  */
+ #define TRANSMIT_RETRY_DELAY       5000
+ /**
+  *	Maximum wait of the delivery status of a packet handed to the radio in ms.
+  */
+ #define TRANSMIT_STATUS_TIMEOUT    XBEE_TX_TIMEOUT
+ /**
+  *	Maximum number of packets waiting for an acknowledgment.
+  */
+ #ifndef TRANSMIT_WINDOW
+  #define TRANSMIT_WINDOW           4
+ #endif
+ /**
+  *	Initial, minimum and maximum timeouts of the acknowledgments in ms.
+  */
+ #define TRANSMIT_RTO_INIT          250
+ #define TRANSMIT_RTO_MIN           40
+ #define TRANSMIT_RTO_MAX           2000
+ /**
+  *	Number of consecutive timeouts without acknowledgment ending a burst.
+  *
+  *  @note The unacknowledged packets are left to the platform's NAK frames.
+  */
+ #define TRANSMIT_TIMEOUT_MAX       3
+ /**
+  *	Default maximum latencies of the classes of frames in ms.
+  */
+ #define TRANSMIT_LATENCY_EVENT     0
+ #define TRANSMIT_LATENCY_SUMMARY   30000
+ #define TRANSMIT_LATENCY_RAW       5000
+ #define TRANSMIT_LATENCY_ALIVE     60000
+
+ /**
+  *	Enumeration of the classes of frames.
+  */
+ typedef enum
+ {
+    cTransmitClassEvent = 0,    /**< Bed events (EVT), urgent. */
+    cTransmitClassSummary,      /**< Summaries (BRE, SPC, EPO). */
+    cTransmitClassRaw,          /**< Raw sampling (DR1, DC1, DCN...). */
+    cTransmitClassAlive,        /**< Keep alive (empty packet). */
+    /* ^-insert new class at the end-^ */
+    /*--------END OF ENUMERATION--------*/
+    cTransmitClassNumber        /**< Number of classes. */
+ } eTransmitClass;
+
+ /**
+  *	Statistics of the scheduler.
+  */
+ struct sTransmitStats
+ {
+    uint32_t awakeTime;     /**< Time spent with the radio woken up in ms. */
+    uint32_t nbBytes;       /**< Number of bytes delivered. */
+    uint16_t nbFrames;      /**< Number of frames queued. */
+    uint16_t nbPackets;     /**< Number of packets delivered. */
+    uint16_t nbResent;      /**< Number of packets delivered again on request of the platform. */
+    uint16_t nbBursts;      /**< Number of bursts. */
+    uint16_t nbFailures;    /**< Number of bursts ended by an undelivered packet. */
+    uint16_t nbDropped;     /**< Number of frames dropped, the spool being full. */
+    uint16_t nbTimeouts;    /**< Number of acknowledgments not received in time. */
+    uint16_t rto;           /**< Current timeout of the acknowledgments in ms. */
+ };
+
+ /**
+  *	Reference of the function handing a packet to the radio.
+  *
+  *  This function should return true once the packet is written to the
+  *  radio, without waiting for its delivery.
+  *
+  *  @warning It must be set by user.
+  */
+ extern bool (*transmit_radioSend)(uint8_t const* data, const uint8_t size);
+ /**
+  *	Reference of the function giving the delivery status of the last packet handed to the radio.
+  *
+  *  This function should return cXbeeStatusPending until the status is
+  *  received, without waiting.
+  *
+  *  @warning It must be set by user.
+  */
+ extern eXbeeStatus (*transmit_radioStatus)(void);
+ /**
+  *	Reference of the function waking up (true) or putting to sleep (false) the radio.
+  *
+  *  This function should return once the radio is ready.
+  *
+  *  @warning It must be set by user.
+  */
+ extern void (*transmit_radioPower)(const bool bOn);
+ /**
+  *	Reference of the function polling the radio while waiting for acknowledgments.
+  *
+  *  The ACK and NAK frames received should be given to transmit_acknowledge()
+  *  and transmit_resend().
+  *
+  *  @warning It must be set by user.
+  */
+ extern void (*transmit_radioReceive)(void);
+ /**
+  *	Reference of the function writing in the spool's memory.
+  *
+  *  @warning It must be set by user.
+  */
+ extern bool (*transmit_spoolWrite)(const uint32_t addr, uint8_t const* data, const uint16_t size);
+ /**
+  *	Reference of the function reading the spool's memory.
+  *
+  *  @warning It must be set by user.
+  */
+ extern bool (*transmit_spoolRead)(const uint32_t addr, uint8_t* data, const uint16_t size);
+ /**
+  *	Reference of the function giving the time in ms.
+  *
+  *  @warning It must be set by user.
+  */
+ extern uint32_t (*transmit_millis)(void);
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Empties the queue, restores default latencies and puts the radio to sleep.
+  */
+ void transmit_init(void);
+
+ /**
+  *	Changes the maximum latency of a class of frames.
+  *
+  *  @param [in] frameClass
+  *      The class of frames.
+  *  @param [in] latency
+  *      Maximum time between the queueing of a frame and its burst in ms.
+  */
+ void transmit_setLatency(const eTransmitClass frameClass, const uint32_t latency);
+
+ /**
+  *	Queues frames.
+  *
+  *  @param [in] data
+  *      Reference to whole frames, as created by the protocol_createXXX() functions.
+  *  @param [in] size
+  *      Size of data.
+  *  @param [in] frameClass
+  *      The class of the frames.
+  *
+  *  @return true hopefully, false if the frames are dropped.
+  */
+ bool transmit_push(uint8_t const* data, const uint16_t size, const eTransmitClass frameClass);
+
+ /**
+  *	Requests a range of frames lost by the platform to be sent again.
+  *
+  *  The frames still in the spool are sent by the next burst, which is due at once.
+  *  Successive requests are merged in a range covering all of them.
+  *
+  *  @param [in] first
+  *      Sequence number of the first lost frame.
+  *  @param [in] last
+  *      Sequence number of the last lost frame.
+  *
+  *  @see protocol_parseNAK()
+  */
+ void transmit_resend(const uint16_t first, const uint16_t last);
+
+ /**
+  *	Acknowledges the frames received by the platform.
+  *
+  *  The packets acknowledged leave the window, and the first hole reported
+  *  is sent again at once.
+  *
+  *  @param [in] seq
+  *      Sequence number of the first frame not received.
+  *  @param [in] mask
+  *      Frames received after it, bit i for frame seq + 1 + i.
+  *
+  *  @see protocol_parseACK()
+  */
+ void transmit_acknowledge(const uint16_t seq, const uint16_t mask);
+
+ /**
+  *	Opens an empty packet, sent as a keep alive if nothing else is queued.
+  *
+  *  @note Its SEQ frame alone lets the platform notice frames lost at the end of the previous burst.
+  */
+ void transmit_keepAlive(void);
+
+ /**
+  *	Runs a step of the burst under way, or starts one if the oldest deadline is reached.
+  *
+  *  @note Should be called until transmit_getDelay() isn't null anymore.
+  *
+  *  @return true if a burst has gone on, false otherwise.
+  */
+ bool transmit_poll(void);
+
+ /**
+  *	Sends a burst right now, or ends the one under way, waiting for its end.
+  *
+  *  @return true if the queue is empty afterwards, false otherwise.
+  */
+ bool transmit_flush(void);
+
+ /**
+  *	Computes the time before the next burst.
+  *
+  *  @return The time in ms, 0 during a burst, UINT32_MAX if the queue is empty.
+  */
+ uint32_t transmit_getDelay(void);
+
+ /**
+  *	Determines if frames are waiting for a burst.
+  *
+  *  @return true if neither frames, nor acknowledgments, nor a request of the platform are waiting, and no burst is under way, false otherwise.
+  */
+ bool transmit_isEmpty(void);
+
+ /**
+  *	Retrieves the statistics of the scheduler.
+  *
+  *  @param [out] sStats
+  *      Reference where store the statistics.
+  */
+ void transmit_getStats(struct sTransmitStats* sStats);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif
@@ -0,0 +1,371 @@
+/**
+ *  @copybrief xbee.h
+ *  @copydetails xbee.h
+ *
+ *  @file xbee.c
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#include "xbee.h"
+
+/**
+ *	Enumeration of the states of the receiver.
+ *
+ *  @internal
+ */
+typedef enum
+{
+    cXbeeRxStart = 0,   /**< Waiting for a start delimiter. */
+    cXbeeRxLengthHigh,  /**< Waiting for the high byte of the length. */
+    cXbeeRxLengthLow,   /**< Waiting for the low byte of the length. */
+    cXbeeRxData,        /**< Receiving frame data. */
+    cXbeeRxChecksum     /**< Waiting for the checksum. */
+} eXbeeRxState;
+
+/**
+ *	State of the receiver.
+ *
+ *  @internal
+ */
+static struct
+{
+    uint8_t  data[XBEE_RX_BUFFER_SIZE]; /**< Frame data of the frame being received. */
+    uint16_t length;                    /**< Length of the frame being received. */
+    uint16_t pos;                       /**< Number of frame data bytes received. */
+    uint8_t  sum;                       /**< Sum of the frame data bytes received. */
+    uint8_t  state;                     /**< Value of eXbeeRxState. */
+    bool     bEscaped;                  /**< true if the previous byte was an escape character. */
+} xbee_rx;
+
+/**
+ *	Standard baud rates sort by value of the BD register, in program memory.
+ *
+ *  @internal
+ */
+static uint32_t const xbee_baudRates[] PROGMEM = {1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200};
+
+/**
+ *	Last frame identifier used.
+ *
+ *  @internal
+ */
+static uint8_t xbee_frameId = 0;
+
+/**
+ *	Frame identifier and delivery status of the last TX request.
+ *
+ *  @internal
+ */
+static uint8_t xbee_txFrameId = 0;
+static uint8_t xbee_txStatus  = cXbeeStatusPending;
+
+/**
+ *	Frame identifier, status and value of the last AT response.
+ *
+ *  @internal
+ */
+static uint8_t  xbee_atFrameId  = 0;
+static uint8_t  xbee_atStatus   = 0;
+static uint32_t xbee_atValue    = 0;
+static bool     xbee_bAtReceived = false;
+
+/**
+ *	Writes a byte of a frame, escaped if needed.
+ *
+ *  @internal
+ *
+ *  @param [in] c
+ *      The byte to write.
+ *  @param [in,out] sum
+ *      Reference to the checksum being computed, NULL for the header.
+ */
+static void xbee_writeEscaped(const uint8_t c, uint8_t* sum);
+
+/**
+ *	Writes a complete API frame.
+ *
+ *  @internal
+ *
+ *  @param [in] header
+ *      Start of the frame data (API identifier and options).
+ *  @param [in] headerSize
+ *      Size of header.
+ *  @param [in] data
+ *      End of the frame data, could be NULL.
+ *  @param [in] dataSize
+ *      Size of data.
+ */
+static void xbee_writeFrame(uint8_t const* header, const uint8_t headerSize, uint8_t const* data, const uint8_t dataSize);
+
+/**
+ *	Computes the next frame identifier.
+ *
+ *  @internal
+ *
+ *  @return A frame identifier, never 0 since it disables responses.
+ */
+static uint8_t xbee_nextFrameId(void);
+
+/**
+ *	Handles a complete and valid received frame.
+ *
+ *  @internal
+ */
+static void xbee_dispatch(void);
+
+static void xbee_writeEscaped(const uint8_t c, uint8_t* sum)
+{
+    if (sum != NULL)
+        *sum += c;
+    if (c == XBEE_START || c == XBEE_ESCAPE || c == 0x11 || c == 0x13)
+    {
+        xbee_writeChar(XBEE_ESCAPE);
+        xbee_writeChar(c ^ XBEE_ESCAPE_XOR);
+    }
+    else
+        xbee_writeChar(c);
+}
+
+static void xbee_writeFrame(uint8_t const* header, const uint8_t headerSize, uint8_t const* data, const uint8_t dataSize)
+{
+    uint16_t length;
+    uint8_t sum;
+    uint8_t i;
+
+    length = headerSize + dataSize;
+    sum = 0;
+
+    xbee_writeChar(XBEE_START);
+    xbee_writeEscaped(length >> 8, NULL);
+    xbee_writeEscaped(length, NULL);
+    for (i = 0 ; i < headerSize ; i++)
+        xbee_writeEscaped(header[i], &sum);
+    for (i = 0 ; i < dataSize ; i++)
+        xbee_writeEscaped(data[i], &sum);
+    xbee_writeEscaped(0xFF - sum, NULL);
+}
+
+static uint8_t xbee_nextFrameId(void)
+{
+    if (++xbee_frameId == 0)
+        xbee_frameId = 1;
+
+    return xbee_frameId;
+}
+
+static void xbee_dispatch(void)
+{
+    uint8_t* data = xbee_rx.data;
+    uint16_t i;
+
+    switch (data[0])
+    {
+        case cXbeeApiAtResponse :
+            /* <API><ID><CMD0><CMD1><STATUS>[<VALUE>] */
+            if (xbee_rx.length >= 5)
+            {
+                xbee_atFrameId = data[1];
+                xbee_atStatus  = data[4];
+                xbee_atValue   = 0;
+                for (i = 5 ; i < xbee_rx.length && i < 9 ; i++)
+                    xbee_atValue = (xbee_atValue << 8) | data[i];
+                xbee_bAtReceived = true;
+            }
+            break;
+        case cXbeeApiTxStatus :
+            /* <API><ID><STATUS> */
+            if (xbee_rx.length >= 3 && data[1] == xbee_txFrameId)
+                xbee_txStatus = data[2];
+            break;
+        case cXbeeApiRx16 :
+            /* <API><SRC0><SRC1><RSSI><OPTIONS><DATA...> */
+            if (xbee_rx.length > 5 && xbee_onReceive != NULL)
+                xbee_onReceive(data + 5, xbee_rx.length - 5);
+            break;
+        default :
+            break;
+    }
+}
+
+bool xbee_poll(void)
+{
+    int read;
+    uint8_t c;
+    bool bFrame = false;
+
+    while ((read = xbee_readChar()) >= 0)
+    {
+        c = read;
+        if (c == XBEE_START)
+        {
+            /* Always a new frame, even in the middle of another one. */
+            xbee_rx.state = cXbeeRxLengthHigh;
+            xbee_rx.bEscaped = false;
+            continue;
+        }
+        if (c == XBEE_ESCAPE)
+        {
+            xbee_rx.bEscaped = true;
+            continue;
+        }
+        if (xbee_rx.bEscaped)
+        {
+            c ^= XBEE_ESCAPE_XOR;
+            xbee_rx.bEscaped = false;
+        }
+
+        switch (xbee_rx.state)
+        {
+            case cXbeeRxLengthHigh :
+                xbee_rx.length = (uint16_t)c << 8;
+                xbee_rx.state = cXbeeRxLengthLow;
+                break;
+            case cXbeeRxLengthLow :
+                xbee_rx.length |= c;
+                xbee_rx.pos = 0;
+                xbee_rx.sum = 0;
+                /* Frames too long for the buffer are dropped. */
+                xbee_rx.state = (xbee_rx.length > 0 && xbee_rx.length <= XBEE_RX_BUFFER_SIZE) ? cXbeeRxData : cXbeeRxStart;
+                break;
+            case cXbeeRxData :
+                xbee_rx.data[xbee_rx.pos++] = c;
+                xbee_rx.sum += c;
+                if (xbee_rx.pos == xbee_rx.length)
+                    xbee_rx.state = cXbeeRxChecksum;
+                break;
+            case cXbeeRxChecksum :
+                if ((uint8_t)(xbee_rx.sum + c) == 0xFF)
+                {
+                    xbee_dispatch();
+                    bFrame = true;
+                }
+                xbee_rx.state = cXbeeRxStart;
+                break;
+            case cXbeeRxStart :
+            default :
+                break;
+        }
+    }
+
+    return bFrame;
+}
+
+bool xbee_getAT(char const command[2], uint32_t* value, const uint16_t timeout)
+{
+    uint8_t header[4];
+    uint32_t start;
+
+    assert(command != NULL);
+    assert(value != NULL);
+
+    header[0] = cXbeeApiAtCommand;
+    header[1] = xbee_nextFrameId();
+    header[2] = progmem_readByte(command);
+    header[3] = progmem_readByte(command + 1);
+
+    xbee_bAtReceived = false;
+    xbee_writeFrame(header, sizeof(header), NULL, 0);
+
+    start = xbee_millis();
+    do
+    {
+        xbee_poll();
+        if (xbee_bAtReceived && xbee_atFrameId == header[1])
+        {
+            *value = xbee_atValue;
+            return (xbee_atStatus == 0);
+        }
+    } while (xbee_millis() - start < timeout);
+
+    return false;
+}
+
+bool xbee_setAT(char const command[2], const uint32_t value, const uint8_t size, const uint16_t timeout)
+{
+    uint8_t header[4];
+    uint8_t data[4];
+    uint32_t start;
+    uint8_t i;
+
+    assert(command != NULL);
+    assert(size <= sizeof(data));
+
+    header[0] = cXbeeApiAtCommand;
+    header[1] = xbee_nextFrameId();
+    header[2] = progmem_readByte(command);
+    header[3] = progmem_readByte(command + 1);
+    for (i = 0 ; i < size ; i++)
+        data[i] = value >> (8 * (size - 1 - i));
+
+    xbee_bAtReceived = false;
+    xbee_writeFrame(header, sizeof(header), data, size);
+
+    start = xbee_millis();
+    do
+    {
+        xbee_poll();
+        if (xbee_bAtReceived && xbee_atFrameId == header[1])
+            return (xbee_atStatus == 0);
+    } while (xbee_millis() - start < timeout);
+
+    return false;
+}
+
+uint8_t xbee_baudCode(const uint32_t rate)
+{
+    uint8_t code;
+
+    for (code = 0 ; code < sizeof(xbee_baudRates) / sizeof(xbee_baudRates[0]) ; code++)
+        if (progmem_readDword(&xbee_baudRates[code]) == rate)
+            return code;
+
+    return XBEE_BAUD_UNKNOWN;
+}
+
+uint8_t xbee_send(uint8_t const* data, const uint8_t size)
+{
+    uint8_t header[5];
+
+    assert(data != NULL);
+    assert(size > 0 && size <= XBEE_PAYLOAD_MAX);
+
+    /* <API><ID><DEST0><DEST1><OPTIONS> */
+    header[0] = cXbeeApiTx16;
+    header[1] = xbee_txFrameId = xbee_nextFrameId();
+    header[2] = (uint16_t)XBEE_DESTINATION >> 8;
+    header[3] = (uint8_t)XBEE_DESTINATION;
+    header[4] = 0;
+    xbee_txStatus = cXbeeStatusPending;
+
+    xbee_writeFrame(header, sizeof(header), data, size);
+
+    return header[1];
+}
+
+eXbeeStatus xbee_getStatus(const uint8_t frameId)
+{
+    xbee_poll();
+
+    return (frameId == xbee_txFrameId) ? (eXbeeStatus)xbee_txStatus : cXbeeStatusPending;
+}
+
+eXbeeStatus xbee_sendAndWait(uint8_t const* data, const uint8_t size, const uint16_t timeout)
+{
+    uint8_t frameId;
+    uint32_t start;
+    eXbeeStatus status;
+
+    frameId = xbee_send(data, size);
+    start = xbee_millis();
+    while ((status = xbee_getStatus(frameId)) == cXbeeStatusPending)
+    {
+        if (xbee_millis() - start >= timeout)
+            return cXbeeStatusTimeout;
+    }
+
+    return status;
+}
@@ -0,0 +1,227 @@
+/**
+ *  XBee 802.15.4 radio's driver in API mode.
+ *
+ *  Exchanges API frames with an XBee configured in escaped API mode (AP=2) :
+ *  local AT commands, TX requests with delivery status and RX packets.
+ *  Nothing blocks without a timeout and the serial link is reached through
+ *  user set functions, so the driver runs against a simulated radio on a host.
+ *
+ *  For more informations, refer to the <a href="http://ftp1.digi.com/support/documentation/90000982_B.pdf">XBee 802.15.4 user guide</a>.
+ *
+ *  @file xbee.h
+ *  @date 18 oct 2026
+ *  @copyright PAWM International
+ *
+ *  @author agent
+ *
+ */
+
+#ifndef XBEE_H
+ #define XBEE_H
+
+ #include <inttypes.h>
+ #include <string.h>
+ #include <assert.h>
+
+ #ifndef __cplusplus
+  #include <stdbool.h>
+ #endif
+
+ #include "progmem.h"
+
+ /**
+  *	Start delimiter of API frames.
+  */
+ #define XBEE_START                 0x7E
+ /**
+  *	Escape character in API mode 2.
+  */
+ #define XBEE_ESCAPE                0x7D
+ /**
+  *	Value xored with escaped characters.
+  */
+ #define XBEE_ESCAPE_XOR            0x20
+ /**
+  *	Maximum RF payload of a TX request in bytes.
+  */
+ #define XBEE_PAYLOAD_MAX           100
+ /**
+  *	Bytes of a TX request around its payload on the serial link, escapes aside.
+  */
+ #define XBEE_TX_OVERHEAD           9
+ /**
+  *	Size of the buffer for received API frames (frame data only).
+  */
+ #define XBEE_RX_BUFFER_SIZE        (XBEE_PAYLOAD_MAX + 8)
+ /**
+  *	16 bits address of the platform's radio.
+  */
+ #ifndef XBEE_DESTINATION
+  #define XBEE_DESTINATION          0x0000
+ #endif
+ /**
+  *	Default timeout of local AT commands in ms.
+  */
+ #define XBEE_AT_TIMEOUT            100
+ /**
+  *	Default timeout of a TX status in ms.
+  *
+  *  @note Covers the radio's retries (RR) and a clear channel assessment.
+  */
+ #define XBEE_TX_TIMEOUT            200
+
+ /**
+  *	Value of xbee_baudCode() for a baud rate unsupported by the radio.
+  */
+ #define XBEE_BAUD_UNKNOWN          0xFF
+
+ /**
+  *	Enumeration of API identifiers used by the driver.
+  */
+ typedef enum
+ {
+    cXbeeApiTx16       = 0x01,  /**< TX request with a 16 bits destination address. */
+    cXbeeApiAtCommand  = 0x08,  /**< Local AT command. */
+    cXbeeApiRx16       = 0x81,  /**< RX packet from a 16 bits address. */
+    cXbeeApiAtResponse = 0x88,  /**< Response to a local AT command. */
+    cXbeeApiTxStatus   = 0x89   /**< Delivery status of a TX request. */
+ } eXbeeApi;
+
+ /**
+  *	Enumeration of delivery status.
+  */
+ typedef enum
+ {
+    cXbeeStatusSuccess = 0,     /**< Acknowledged by the destination. */
+    cXbeeStatusNoAck,           /**< No acknowledgment after all retries. */
+    cXbeeStatusCcaFailure,      /**< The channel was never clear. */
+    cXbeeStatusPurged,          /**< Purged by the radio. */
+    /* ^-insert new status at the end-^ */
+    /*--------END OF ENUMERATION--------*/
+    cXbeeStatusTimeout,         /**< No status received in time. */
+    cXbeeStatusPending          /**< Status not yet received. */
+ } eXbeeStatus;
+
+ /**
+  *	Reference of the function reading the serial link.
+  *
+  *  This function should return the next byte received
+  *  or -1 if there is none, without waiting.
+  *
+  *  @warning It must be set by user.
+  */
+ extern int (*xbee_readChar)(void);
+ /**
+  *	Reference of the function writing a byte on the serial link.
+  *
+  *  @warning It must be set by user.
+  */
+ extern void (*xbee_writeChar)(const uint8_t c);
+ /**
+  *	Reference of the function giving the time in ms.
+  *
+  *  @warning It must be set by user.
+  */
+ extern uint32_t (*xbee_millis)(void);
+ /**
+  *	Reference of the function called with the payload of each RX packet.
+  *
+  *  @note Could be left to NULL to ignore received data.
+  */
+ extern void (*xbee_onReceive)(uint8_t const* data, const uint8_t size);
+
+ #ifdef __cplusplus
+  extern "C"{
+ #endif
+
+ /**
+  *	Processes the bytes received from the radio.
+  *
+  *  Never waits : returns as soon as no more byte is available.
+  *
+  *  @return true if at least one complete API frame has been processed, false otherwise.
+  */
+ bool xbee_poll(void);
+
+ /**
+  *	Sends a local AT command reading a register and waits for its value.
+  *
+  *  @param [in] command
+  *      The two letters of the command in program memory, PSTR("SH") for example.
+  *  @param [out] value
+  *      Reference where store the register (up to 4 bytes, big endian on the link).
+  *  @param [in] timeout
+  *      Maximum time to wait for the response in ms.
+  *
+  *  @return true hopefully, false on timeout or error status.
+  */
+ bool xbee_getAT(char const command[2], uint32_t* value, const uint16_t timeout);
+
+ /**
+  *	Sends a local AT command writing a register and waits for its status.
+  *
+  *  @param [in] command
+  *      The two letters of the command in program memory, PSTR("BD") for example.
+  *  @param [in] value
+  *      Value of the register.
+  *  @param [in] size
+  *      Number of bytes of the value on the link [0;4].
+  *  @param [in] timeout
+  *      Maximum time to wait for the response in ms.
+  *
+  *  @return true hopefully, false on timeout or error status.
+  */
+ bool xbee_setAT(char const command[2], const uint32_t value, const uint8_t size, const uint16_t timeout);
+
+ /**
+  *	Converts a baud rate to the value of the BD register.
+  *
+  *  @param [in] rate
+  *      Baud rate in bps.
+  *
+  *  @return The value of the BD register, XBEE_BAUD_UNKNOWN if the rate isn't a standard one.
+  */
+ uint8_t xbee_baudCode(const uint32_t rate);
+
+ /**
+  *	Sends data to the platform in a TX request.
+  *
+  *  @param [in] data
+  *      Reference to the data.
+  *  @param [in] size
+  *      Size of data [1;XBEE_PAYLOAD_MAX].
+  *
+  *  @return The frame identifier to follow the delivery status.
+  *
+  *  @see xbee_getStatus()
+  */
+ uint8_t xbee_send(uint8_t const* data, const uint8_t size);
+
+ /**
+  *	Retrieves the delivery status of the last TX request.
+  *
+  *  @param [in] frameId
+  *      Frame identifier returned by xbee_send().
+  *
+  *  @return The delivery status, cXbeeStatusPending if it's unknown yet.
+  */
+ eXbeeStatus xbee_getStatus(const uint8_t frameId);
+
+ /**
+  *	Sends data to the platform and waits for the delivery status.
+  *
+  *  @param [in] data
+  *      Reference to the data.
+  *  @param [in] size
+  *      Size of data [1;XBEE_PAYLOAD_MAX].
+  *  @param [in] timeout
+  *      Maximum time to wait for the status in ms.
+  *
+  *  @return The delivery status.
+  */
+ eXbeeStatus xbee_sendAndWait(uint8_t const* data, const uint8_t size, const uint16_t timeout);
+
+ #ifdef __cplusplus
+  }
+ #endif
+#endif